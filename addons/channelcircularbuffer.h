@@ -0,0 +1,171 @@
+#ifndef CIRCULAR_BUFFER_CHANNELCIRCULARBUFFER_H
+#define CIRCULAR_BUFFER_CHANNELCIRCULARBUFFER_H
+
+#include <coroutine>
+#include <optional>
+
+#include "spsccircularbuffer.h"
+
+
+namespace addons {
+    /**
+     * @brief A coroutine channel adapter over the buffer family.
+     *  `co_await channel.async_pop()` suspends while the buffer is
+     *  empty and `co_await channel.async_push(v)` suspends while it is
+     *  full; each side resumes the other when it makes progress, so one
+     *  executor thread can multiplex many channels instead of parking a
+     *  thread per buffer.
+     *
+     *  The pending coroutine handle lives inside the awaiter object in
+     *  the coroutine frame and the channel only keeps a raw pointer to
+     *  it, so suspension allocates nothing. One coroutine may be parked
+     *  per side at a time; all operations must come from one thread.
+     *  Storage is an SPSCCircularBuffer, whose index-based bookkeeping
+     *  keeps try_push_back exact on wrapped states.
+     *
+     *  @ingroup sequences
+     *
+     * @tparam Tp  Type of element
+     */
+    template<typename Tp, typename Alloc = std::allocator<Tp>>
+    class ChannelCircularBuffer {
+    public:
+        typedef Tp value_type;
+        typedef Alloc allocator_type;
+        typedef size_t size_type;
+
+    private:
+        /// Awaiter for async_push; owns the value across the suspension.
+        struct PushAwaiter {
+            ChannelCircularBuffer& channel;
+            value_type value;
+            std::coroutine_handle<> handle;
+            bool stored;
+
+            bool await_ready()
+            {
+                if (channel.ring.try_push_back(std::move(value))) {
+                    stored = true;
+                    channel._resume_consumer();
+                    return true;
+                }
+                return false;
+            }
+
+            void await_suspend(std::coroutine_handle<> _handle)
+            {
+                handle = _handle;
+                channel.pending_producer = this;
+            }
+
+            void await_resume()
+            {
+                // The consumer that resumed us popped first, so the
+                // slot it vacated is still free here.
+                if (!stored)
+                    channel.ring.try_push_back(std::move(value));
+            }
+        };
+
+        /// Awaiter for async_pop; carries the popped value out.
+        struct PopAwaiter {
+            ChannelCircularBuffer& channel;
+            std::optional<value_type> value;
+            std::coroutine_handle<> handle;
+
+            bool await_ready()
+            {
+                value = channel.ring.try_pop_front();
+                if (value) {
+                    channel._resume_producer();
+                    return true;
+                }
+                return false;
+            }
+
+            void await_suspend(std::coroutine_handle<> _handle)
+            {
+                handle = _handle;
+                channel.pending_consumer = this;
+            }
+
+            value_type await_resume()
+            {
+                if (!value) {
+                    value = channel.ring.try_pop_front();
+                    channel._resume_producer();
+                }
+                return std::move(*value);
+            }
+        };
+
+        SPSCCircularBuffer<Tp, Alloc> ring;
+        PushAwaiter* pending_producer;
+        PopAwaiter* pending_consumer;
+
+        void _resume_producer()
+        {
+            if (pending_producer) {
+                PushAwaiter* parked = pending_producer;
+                pending_producer = nullptr;
+                parked->handle.resume();
+            }
+        }
+
+        void _resume_consumer()
+        {
+            if (pending_consumer) {
+                PopAwaiter* parked = pending_consumer;
+                pending_consumer = nullptr;
+                parked->handle.resume();
+            }
+        }
+
+    public:
+        // Constructors
+
+        explicit ChannelCircularBuffer(size_type _n)
+            : ring(_n), pending_producer(), pending_consumer()
+        {}
+
+        ChannelCircularBuffer(const ChannelCircularBuffer&) = delete;
+        ChannelCircularBuffer& operator=(const ChannelCircularBuffer&) = delete;
+
+        // Public member functions
+
+        [[nodiscard]] size_type capacity() const noexcept
+        {
+            return ring.capacity();
+        }
+
+        [[nodiscard]] size_type size() const noexcept
+        {
+            return ring.size();
+        }
+
+        [[nodiscard]] bool empty() const noexcept
+        {
+            return ring.empty();
+        }
+
+        /// Awaitable push; suspends while the buffer is full.
+        PushAwaiter async_push(const value_type& _value)
+        {
+            return PushAwaiter{*this, _value, {}, false};
+        }
+
+        /// Awaitable push; suspends while the buffer is full.
+        PushAwaiter async_push(value_type&& _value)
+        {
+            return PushAwaiter{*this, std::move(_value), {}, false};
+        }
+
+        /// Awaitable pop; suspends while the buffer is empty.
+        PopAwaiter async_pop()
+        {
+            return PopAwaiter{*this, std::nullopt, {}};
+        }
+    };
+}
+
+#endif
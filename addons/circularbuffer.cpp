@@ -1 +1,14 @@
 #include "circularbuffer.h"
+#include "channelcircularbuffer.h"
+#include "circularbufferalgo.h"
+#include "circularbytebuffer.h"
+#include "circularbufferpow2.h"
+#include "circularbufferstatic.h"
+#include "cowcircularbuffer.h"
+#include "hugepageallocator.h"
+#include "mappedcircularbuffer.h"
+#include "poolallocator.h"
+#include "shardedcircularbuffer.h"
+#include "spsccircularbuffer.h"
+#include "waitablecircularbuffer.h"
+#include "mpmccircularbuffer.h"
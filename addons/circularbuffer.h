@@ -1,13 +1,74 @@
 #ifndef CIRCULAR_BUFFER_CIRCULARBUFFER_H
 #define CIRCULAR_BUFFER_CIRCULARBUFFER_H
 
+#include <array>
+#include <compare>
+#include <cstdint>
+#include <cstring>
+#include <istream>
+#include <iterator>
 #include <memory>
+#include <optional>
+#include <ostream>
+#include <span>
+#include <thread>
+#include <vector>
+#ifdef __unix__
+#include <sys/uio.h>
+#include <unistd.h>
+#endif
 
 
 namespace addons {
-    template<typename Ptr>
+    /// What push_back/push_front do when the buffer is full.
+    enum class OverflowPolicy {
+        Overwrite,  ///< drop the element at the opposite side (default)
+        Reject      ///< leave the buffer untouched
+    };
+
+    template<typename Tp, typename Alloc = std::allocator<Tp>,
+             OverflowPolicy Policy = OverflowPolicy::Overwrite>
+    class CircularBuffer;
+
+    template<typename Ptr,
+             typename Container = CircularBuffer<typename std::iterator_traits<Ptr>::value_type>>
     class CBuffIterator;
 
+#ifdef CIRCULARBUFFER_STATS
+    /// Counters collected by the buffer classes when compiled with
+    /// CIRCULARBUFFER_STATS; see stats().
+    struct CBuffStats {
+        size_t reallocations;
+        size_t bytes_relocated;
+        size_t wrap_arounds;
+        size_t overwritten;
+        size_t max_occupancy;
+    };
+#endif
+
+    /// On-disk layout written by dump() and validated by restore().
+    struct CBuffDumpHeader {
+        static constexpr uint64_t MAGIC = 0x504D554446465542ull; // "BUFFDUMP"
+
+        uint64_t magic;
+        uint64_t element_size;
+        uint64_t count;
+        uint64_t capacity;
+    };
+
+    /**
+     * @brief Opt-in trait marking a type safe to relocate as raw
+     *  bytes, with no per-element construct/destroy. Detected
+     *  automatically for trivially copyable types; specialize to
+     *  std::true_type for user types whose move-plus-destroy is
+     *  equivalent to a byte copy.
+     */
+    template<typename Tp>
+    struct is_trivially_relocatable : std::bool_constant<std::is_trivially_copyable_v<Tp>> {};
+
+    template<typename Tp>
+    inline constexpr bool is_trivially_relocatable_v = is_trivially_relocatable<Tp>::value;
+
     /**
      * @brief A container which offers fixed time access to
      *  individual elements in any order. Differs from vector only
@@ -16,9 +77,11 @@ namespace addons {
      *
      *  @ingroup sequences
      *
-     * @tparam Tp  Type of element
+     * @tparam Tp      Type of element
+     * @tparam Policy  Compile-time choice between overwriting the
+     *  oldest element and rejecting the push when the buffer is full
      */
-    template<typename Tp, typename Alloc=std::allocator<Tp>>
+    template<typename Tp, typename Alloc, OverflowPolicy Policy>
     class CircularBuffer {
     public:
         typedef Tp value_type;
@@ -27,58 +90,113 @@ namespace addons {
         typedef const Tp* const_pointer;
         typedef Tp& reference;
         typedef const Tp& const_reference;
-        typedef CBuffIterator<pointer> iterator;
-        typedef const CBuffIterator<pointer> const_iterator;
+        typedef CBuffIterator<pointer, CircularBuffer> iterator;
+        typedef const CBuffIterator<pointer, CircularBuffer> const_iterator;
         typedef std::reverse_iterator<iterator> reverse_iterator;
         typedef std::reverse_iterator<const_iterator> const_reverse_iterator;
         typedef size_t size_type;
         typedef ptrdiff_t difference_type;
+        typedef std::pair<pointer, size_type> array_range;
+        typedef std::pair<const_pointer, size_type> const_array_range;
 
     private:
         pointer start;
         pointer finish;
         pointer start_of_storage;
         pointer end_of_storage;
+        size_type count;
         allocator_type alloc;
+#ifdef CIRCULARBUFFER_STATS
+        CBuffStats stats_counters{};
+#endif
 
     public:
         // Constructors / destructors / copy
 
         CircularBuffer() noexcept
-            : start(), finish(), start_of_storage(), end_of_storage()
+            : start(), finish(), start_of_storage(), end_of_storage(), count()
         {}
 
         CircularBuffer(const CircularBuffer& _x) noexcept
+            : alloc(std::allocator_traits<allocator_type>::select_on_container_copy_construction(_x.alloc))
         {
-            start = start_of_storage = alloc.allocate(_x.capacity());
+            start = start_of_storage = std::allocator_traits<allocator_type>::allocate(alloc, _x.capacity());
             finish = start + _x.size();
             end_of_storage = start_of_storage + _x.capacity();
+            count = _x.size();
             std::__uninitialized_copy_a(_x.begin(), _x.end(), start, alloc);
         }
 
+        CircularBuffer(CircularBuffer&& _x) noexcept
+            : start(_x.start), finish(_x.finish), start_of_storage(_x.start_of_storage),
+              end_of_storage(_x.end_of_storage), count(_x.count),
+              alloc(std::move(_x.alloc))
+        {
+            _x.start_of_storage = _x.start = _x.end_of_storage = _x.finish = pointer();
+            _x.count = 0;
+        }
+
         CircularBuffer(std::initializer_list<value_type> _list)
         {
-            start = start_of_storage = alloc.allocate(_list.size());
+            start = start_of_storage = std::allocator_traits<allocator_type>::allocate(alloc, _list.size());
             finish = end_of_storage = start + _list.size();
+            count = _list.size();
             std::__uninitialized_copy_a(_list.begin(), _list.end(), start, alloc);
         }
 
         CircularBuffer& operator=(const CircularBuffer& _x)
         {
             clear();
-            start = start_of_storage = alloc.allocate(_x.capacity());
+            if constexpr (std::allocator_traits<allocator_type>::propagate_on_container_copy_assignment::value)
+                alloc = _x.alloc;
+            start = start_of_storage = std::allocator_traits<allocator_type>::allocate(alloc, _x.capacity());
             finish = start + _x.size();
             end_of_storage = start_of_storage + _x.capacity();
+            count = _x.size();
             std::__uninitialized_copy_a(_x.begin(), _x.end(), start, alloc);
 
             return *this;
         }
 
+        CircularBuffer& operator=(CircularBuffer&& _x)
+            noexcept(std::allocator_traits<allocator_type>::propagate_on_container_move_assignment::value
+                     || std::allocator_traits<allocator_type>::is_always_equal::value)
+        {
+            clear();
+            if constexpr (std::allocator_traits<allocator_type>::propagate_on_container_move_assignment::value) {
+                alloc = std::move(_x.alloc);
+            } else if constexpr (!std::allocator_traits<allocator_type>::is_always_equal::value) {
+                if (alloc != _x.alloc) {
+                    // Storage from an incompatible allocator cannot be
+                    // adopted: allocate with ours and move the elements.
+                    start = start_of_storage = std::allocator_traits<allocator_type>::allocate(alloc, _x.capacity());
+                    finish = start + _x.size();
+                    end_of_storage = start_of_storage + _x.capacity();
+                    count = _x.size();
+                    std::__uninitialized_copy_a(std::make_move_iterator(_x.begin()),
+                                                std::make_move_iterator(_x.end()), start, alloc);
+                    _x.clear();
+
+                    return *this;
+                }
+            }
+            start = _x.start;
+            finish = _x.finish;
+            start_of_storage = _x.start_of_storage;
+            end_of_storage = _x.end_of_storage;
+            count = _x.count;
+            _x.start_of_storage = _x.start = _x.end_of_storage = _x.finish = pointer();
+            _x.count = 0;
+
+            return *this;
+        }
+
         CircularBuffer& operator=(std::initializer_list<value_type> _list)
         {
             clear();
-            start = start_of_storage = alloc.allocate(_list.size());
+            start = start_of_storage = std::allocator_traits<allocator_type>::allocate(alloc, _list.size());
             finish = end_of_storage = start + _list.size();
+            count = _list.size();
             std::__uninitialized_copy_a(_list.begin(), _list.end(), start, alloc);
 
             return *this;
@@ -86,20 +204,41 @@ namespace addons {
 
         explicit CircularBuffer(size_type _n)
         {
-            start = start_of_storage = finish = alloc.allocate(_n);
+            start = start_of_storage = finish = std::allocator_traits<allocator_type>::allocate(alloc, _n);
             end_of_storage = start_of_storage + _n;
+            count = 0;
         }
 
         explicit CircularBuffer(size_type _n, const_reference _value)
         {
-            start = start_of_storage = alloc.allocate(_n);
+            start = start_of_storage = std::allocator_traits<allocator_type>::allocate(alloc, _n);
             end_of_storage = start_of_storage + _n;
             finish = std::__uninitialized_fill_n_a(start, _n, _value, alloc);
+            count = _n;
+        }
+
+        /**
+         * @brief Same as the filled constructor, but splits the fill
+         *  over _threads contiguous chunks constructed concurrently.
+         *  First-touching the pages from several threads also spreads
+         *  them across NUMA nodes. The element copy constructor must
+         *  not throw.
+         */
+        CircularBuffer(size_type _n, const_reference _value, size_type _threads)
+        {
+            start = start_of_storage = std::allocator_traits<allocator_type>::allocate(alloc, _n);
+            end_of_storage = start_of_storage + _n;
+            _parallel_chunks(start_of_storage, _n, _threads,
+                             [this, &_value](pointer _first, size_type _count) {
+                                 std::__uninitialized_fill_n_a(_first, _count, _value, alloc);
+                             });
+            finish = end_of_storage;
+            count = _n;
         }
 
         template<typename InputIterator, typename = std::_RequireInputIter<InputIterator>>
         CircularBuffer(InputIterator _first, InputIterator _last)
-        : start(), finish(), start_of_storage(), end_of_storage()
+        : start(), finish(), start_of_storage(), end_of_storage(), count()
         {
             assign(_first, _last);
         }
@@ -209,16 +348,12 @@ namespace addons {
 
         [[nodiscard]] bool empty() const noexcept
         {
-            return start == finish;
+            return count == 0;
         }
 
         [[nodiscard]] size_type size() const noexcept
         {
-            return start <= finish && finish != end_of_storage ?
-                   finish - start :
-                   finish != end_of_storage ?
-                   (finish - start_of_storage) + (end_of_storage - start) :
-                   end_of_storage - start_of_storage;
+            return count;
         }
 
         [[nodiscard]] size_type max_size() const noexcept
@@ -238,10 +373,12 @@ namespace addons {
             if (_new_size > max_size())
                 throw std::length_error("resizing overheads maximum size");
             if (_new_size > size()) {
-                if (_new_size > capacity())
+                if (_new_size > capacity()) {
                     _reallocate_storage_default(_new_size);
-                else
+                } else {
                     finish = std::__uninitialized_default_n_a(end(), _new_size - size(), alloc).get_ptr();
+                    count = _new_size;
+                }
             } else if (_new_size) {
                 _erase_ending(size() - _new_size);
             }
@@ -252,10 +389,12 @@ namespace addons {
             if (_new_size > max_size())
                 throw std::length_error("resizing overheads maximum size");
             if (_new_size > size()) {
-                if (_new_size > capacity())
+                if (_new_size > capacity()) {
                     _reallocate_storage_filled(_new_size, _value);
-                else
+                } else {
                     finish = std::__uninitialized_fill_n_a(end(), _new_size - size(), _value, alloc).get_ptr();
+                    count = _new_size;
+                }
             } else {
                 _erase_ending(size() - _new_size);
             }
@@ -314,169 +453,196 @@ namespace addons {
             return begin().at(_offset);
         }
 
+        /**
+         * @brief First physical contiguous run of elements, starting at
+         *  the logical front. {pointer, length}; length 0 when empty.
+         */
+        array_range array_one() noexcept
+        {
+            if (empty())
+                return array_range(start, 0);
+            if (finish == end_of_storage || finish < start)
+                return array_range(start, end_of_storage - start);
+            return array_range(start, finish - start);
+        }
+
+        const_array_range array_one() const noexcept
+        {
+            if (empty())
+                return const_array_range(start, 0);
+            if (finish == end_of_storage || finish < start)
+                return const_array_range(start, end_of_storage - start);
+            return const_array_range(start, finish - start);
+        }
+
+        /**
+         * @brief Second physical contiguous run, the part wrapped to the
+         *  beginning of storage. Length 0 when the content is one run.
+         */
+        array_range array_two() noexcept
+        {
+            if (empty())
+                return array_range(start_of_storage, 0);
+            if (finish == end_of_storage)
+                return array_range(start_of_storage, start - start_of_storage);
+            if (finish < start)
+                return array_range(start_of_storage, finish - start_of_storage);
+            return array_range(start_of_storage, 0);
+        }
+
+        const_array_range array_two() const noexcept
+        {
+            if (empty())
+                return const_array_range(start_of_storage, 0);
+            if (finish == end_of_storage)
+                return const_array_range(start_of_storage, start - start_of_storage);
+            if (finish < start)
+                return const_array_range(start_of_storage, finish - start_of_storage);
+            return const_array_range(start_of_storage, 0);
+        }
+
+        /**
+         * @brief Rotates storage so the content is a single contiguous
+         *  run starting at the beginning of storage. Returns a pointer
+         *  to the first element.
+         */
+        pointer linearize()
+        {
+            if (!empty() && array_two().second)
+                _reallocate_storage_default(capacity());
+            return start;
+        }
+
+        /**
+         * @brief Invokes _fn(first, last) with raw pointers over each of
+         *  the at-most-two contiguous runs, front run first. User loops
+         *  over the pointers compile to straight-line code the way
+         *  iteration through CBuffIterator cannot.
+         */
+        template<typename Fn>
+        void for_each_segment(Fn&& _fn)
+        {
+            const array_range one = array_one();
+            if (one.second)
+                _fn(one.first, one.first + one.second);
+            const array_range two = array_two();
+            if (two.second)
+                _fn(two.first, two.first + two.second);
+        }
+
+        template<typename Fn>
+        void for_each_segment(Fn&& _fn) const
+        {
+            const const_array_range one = array_one();
+            if (one.second)
+                _fn(one.first, one.first + one.second);
+            const const_array_range two = array_two();
+            if (two.second)
+                _fn(two.first, two.first + two.second);
+        }
+
+        /// Both physical runs as {pointer, length} pairs, front run first.
+        std::array<array_range, 2> segments() noexcept
+        {
+            return {array_one(), array_two()};
+        }
+
+        std::array<const_array_range, 2> segments() const noexcept
+        {
+            return {array_one(), array_two()};
+        }
+
         template<typename InputIterator, typename = std::_RequireInputIter<InputIterator>>
         void insert(iterator _pos, InputIterator _first, InputIterator _last)
         {
-            if (_pos - begin() >= end() - _pos) {
-                difference_type n_moved = end() - _pos;
-                pointer tmp = alloc.allocate(n_moved);
-                std::__relocate_a(_pos,
-                                  end(),
-                                  tmp, alloc);
-                auto cur = _pos;
-                for (; _first < _last; _first++, cur++) {
-                    if (cur == end()) {
-                        if (end().get_ptr() == end_of_storage) {
-                            cur = begin();
-                        } else {
-                            finish++;
-                            cur = --end();
-                        }
-                    }
-                    *cur = *_first;
-                }
-                const_pointer moved_end = tmp + n_moved;
-                for (; tmp < moved_end; tmp++, cur++) {
-                    if (end().get_ptr() == end_of_storage) {
-                        cur = begin();
-                    } else {
-                        finish++;
-                        cur = --end();
-                    }
-                    *cur = *tmp;
-                }
-                finish = cur.get_ptr();
-                alloc.deallocate(tmp, n_moved);
-            } else {
-                difference_type n_moved = end() - _pos;
-                pointer tmp = alloc.allocate(n_moved);
-                std::__relocate_a(reverse_iterator(_pos),
-                                  reverse_iterator(begin()),
-                                  tmp, alloc);
-                auto cur = reverse_iterator(_pos);
-                _first = std::reverse_iterator(_first);
-                _last = std::reverse_iterator(_last);
-                for (; _first < _last; _first++, cur++) {
-                    if (cur == begin()) {
-                        if (end().get_ptr() == end_of_storage) {
-                            cur = --end();
-                        } else {
-                            start--;
-                            cur = --begin();
-                        }
-                    }
-                    *cur = *_first;
-                }
-                const_pointer moved_end = tmp + n_moved;
-                for (; tmp < moved_end; tmp++, cur++) {
-                    if (cur == begin()) {
-                        if (end().get_ptr() == end_of_storage) {
-                            cur = --end();
-                        } else {
-                            start--;
-                            cur = --begin();
-                        }
-                    }
-                    *cur = *tmp;
-                }
-                start = (cur + 1).get_ptr();
-                alloc.deallocate(tmp, n_moved);
-            }
-        };
+            const size_type n = _last - _first;
+            if (n == 0 || capacity() == 0)
+                return;
+            const size_type gap = _open_gap(_logical_index(_pos.get_ptr()), n);
+            const size_type cap = capacity();
+            const size_type head_idx = start - start_of_storage;
+            for (size_type filled = 0; _first != _last; ++_first, filled++)
+                start_of_storage[(head_idx + gap + filled) % cap] = *_first;
+        }
 
         void insert(const_iterator _pos, size_type _n, const value_type& _value)
+        {
+            if (_n == 0 || capacity() == 0)
+                return;
+            const size_type gap = _open_gap(_logical_index(_pos.get_ptr()), _n);
+            const size_type cap = capacity();
+            const size_type head_idx = start - start_of_storage;
+            for (size_type filled = 0; filled < _n; filled++)
+                start_of_storage[(head_idx + gap + filled) % cap] = _value;
+        }
+
+        void insert(const_iterator _pos, const value_type& _value)
         {
             if (_pos - begin() >= end() - _pos) {
-                difference_type n_moved = end() - _pos;
-                pointer tmp = alloc.allocate(n_moved);
-                std::__relocate_a(_pos,
-                                  end(),
-                                  tmp, alloc);
-                auto cur = _pos;
-                for (auto filled = 0; filled < _n; filled++, cur++) {
-                    if (cur == end()) {
-                        if (end().get_ptr() == end_of_storage) {
-                            cur = begin();
-                        } else {
-                            finish++;
-                            cur = --end();
-                        }
-                    }
-                    *cur = _value;
+                if (finish == end_of_storage) {
+                    start = (++begin()).get_ptr();
+                    _stat_overwrite(1);
+                } else {
+                    finish++;
+                    count++;
+                    _stat_occupancy();
                 }
-                const_pointer moved_end = tmp + n_moved;
-                for (; tmp < moved_end; tmp++, cur++) {
-                    if (end().get_ptr() == end_of_storage) {
-                        cur = begin();
-                    } else {
-                        finish++;
-                        cur = --end();
-                    }
-                    *cur = *tmp;
+                auto r_pos = const_reverse_iterator(_pos);
+                for (auto cur = rbegin(); cur != r_pos; cur++) {
+                    std::swap(*cur, *(cur + 1));
                 }
-                finish = cur.get_ptr();
-                alloc.deallocate(tmp, n_moved);
+                *_pos = _value;
             } else {
-                difference_type n_moved = end() - _pos;
-                pointer tmp = alloc.allocate(n_moved);
-                std::__relocate_a(const_reverse_iterator(_pos),
-                                  reverse_iterator(begin()),
-                                  tmp, alloc);
-                auto cur = *const_cast<iterator*>(&_pos);
-                for (auto filled = 0; filled < _n; filled++, --_pos) {
-                    if (cur == begin()) {
-                        if (end().get_ptr() == end_of_storage) {
-                            cur = --end();
-                        } else {
-                            start--;
-                            cur = --begin();
-                        }
-                    }
-                    *cur = _value;
+                if (finish == end_of_storage) {
+                    start = (--end()).get_ptr();
+                    _stat_overwrite(1);
+                } else {
+                    if (start != start_of_storage)
+                        start--;
+                    else
+                        start = end_of_storage - 1;
+                    count++;
+                    _stat_occupancy();
                 }
-                const_pointer moved_end = tmp + n_moved;
-                for (; tmp < moved_end; tmp++, cur++) {
-                    if (cur == begin()) {
-                        if (end().get_ptr() == end_of_storage) {
-                            cur = --end();
-                        } else {
-                            start--;
-                            cur = --begin();
-                        }
-                    }
-                    *cur = *tmp;
+                for (auto cur = begin(); cur != _pos - 1; ++cur) {
+                    std::swap(*cur, *(cur + 1));
                 }
-                start = (++cur).get_ptr();
-                alloc.deallocate(tmp, n_moved);
+                *(_pos - 1) = _value;
             }
-        };
+        }
 
-        void insert(const_iterator _pos, const value_type& _value)
+        void insert(const_iterator _pos, value_type&& _value)
         {
             if (_pos - begin() >= end() - _pos) {
                 if (finish == end_of_storage) {
                     start = (++begin()).get_ptr();
+                    _stat_overwrite(1);
                 } else {
                     finish++;
+                    count++;
+                    _stat_occupancy();
                 }
                 auto r_pos = const_reverse_iterator(_pos);
                 for (auto cur = rbegin(); cur != r_pos; cur++) {
                     std::swap(*cur, *(cur + 1));
                 }
-                *_pos = _value;
+                *_pos = std::move(_value);
             } else {
                 if (finish == end_of_storage) {
                     start = (--end()).get_ptr();
+                    _stat_overwrite(1);
                 } else {
                     if (start != start_of_storage)
                         start--;
                     else
                         start = end_of_storage - 1;
+                    count++;
+                    _stat_occupancy();
                 }
                 for (auto cur = begin(); cur != _pos - 1; ++cur) {
                     std::swap(*cur, *(cur + 1));
                 }
-                *(_pos - 1) = _value;
+                *(_pos - 1) = std::move(_value);
             }
         }
 
@@ -488,33 +654,423 @@ namespace addons {
         void push_back(const value_type& _value)
         {
             if (finish == end_of_storage) {
+                if constexpr (Policy == OverflowPolicy::Reject)
+                    return;
                 *begin() = _value;
                 start = (++begin()).get_ptr();
+                _stat_overwrite(1);
             } else {
                 finish++;
+                count++;
+                _stat_occupancy();
+                if (finish == start)
+                    finish = end_of_storage;
                 *(--end()) = _value;
             }
         }
 
+        void push_back(value_type&& _value)
+        {
+            if (finish == end_of_storage) {
+                if constexpr (Policy == OverflowPolicy::Reject)
+                    return;
+                *begin() = std::move(_value);
+                start = (++begin()).get_ptr();
+                _stat_overwrite(1);
+            } else {
+                finish++;
+                count++;
+                _stat_occupancy();
+                if (finish == start)
+                    finish = end_of_storage;
+                *(--end()) = std::move(_value);
+            }
+        }
+
         void push_front(const value_type& _value)
         {
             if (finish == end_of_storage) {
+                if constexpr (Policy == OverflowPolicy::Reject)
+                    return;
                 *(--end()) = _value;
                 start = (--end()).get_ptr();
+                _stat_overwrite(1);
             } else {
-                if (start != start_of_storage)
+                if (start != start_of_storage) {
                     start--;
-                else
+                } else {
                     start = end_of_storage - 1;
+                    _stat_wrap();
+                }
+                count++;
+                _stat_occupancy();
+                if (start == finish)
+                    finish = end_of_storage;
                 *begin() = _value;
             }
         }
 
+        void push_front(value_type&& _value)
+        {
+            if (finish == end_of_storage) {
+                if constexpr (Policy == OverflowPolicy::Reject)
+                    return;
+                *(--end()) = std::move(_value);
+                start = (--end()).get_ptr();
+                _stat_overwrite(1);
+            } else {
+                if (start != start_of_storage) {
+                    start--;
+                } else {
+                    start = end_of_storage - 1;
+                    _stat_wrap();
+                }
+                count++;
+                _stat_occupancy();
+                if (start == finish)
+                    finish = end_of_storage;
+                *begin() = std::move(_value);
+            }
+        }
+
+        /// Under OverflowPolicy::Reject a full buffer is left untouched
+        /// and the existing back element is returned.
+        template<typename... Args>
+        reference emplace_back(Args&&... _args)
+        {
+            if (finish == end_of_storage) {
+                if constexpr (Policy == OverflowPolicy::Reject)
+                    return back();
+                *begin() = value_type(std::forward<Args>(_args)...);
+                start = (++begin()).get_ptr();
+                _stat_overwrite(1);
+            } else {
+                finish++;
+                count++;
+                _stat_occupancy();
+                if (finish == start)
+                    finish = end_of_storage;
+                pointer new_place = (--end()).get_ptr();
+                std::_Destroy(new_place);
+                std::allocator_traits<allocator_type>::construct(alloc, new_place, std::forward<Args>(_args)...);
+            }
+
+            return back();
+        }
+
+        /// Under OverflowPolicy::Reject a full buffer is left untouched
+        /// and the existing front element is returned.
+        template<typename... Args>
+        reference emplace_front(Args&&... _args)
+        {
+            if (finish == end_of_storage) {
+                if constexpr (Policy == OverflowPolicy::Reject)
+                    return front();
+                *(--end()) = value_type(std::forward<Args>(_args)...);
+                start = (--end()).get_ptr();
+                _stat_overwrite(1);
+            } else {
+                if (start != start_of_storage) {
+                    start--;
+                } else {
+                    start = end_of_storage - 1;
+                    _stat_wrap();
+                }
+                count++;
+                _stat_occupancy();
+                if (start == finish)
+                    finish = end_of_storage;
+                std::_Destroy(start);
+                std::allocator_traits<allocator_type>::construct(alloc, start, std::forward<Args>(_args)...);
+            }
+
+            return front();
+        }
+
+        /// Appends only when there is free space; returns whether it did.
+        bool try_push_back(const value_type& _value)
+        {
+            if (finish == end_of_storage)
+                return false;
+            push_back(_value);
+            return true;
+        }
+
+        bool try_push_back(value_type&& _value)
+        {
+            if (finish == end_of_storage)
+                return false;
+            push_back(std::move(_value));
+            return true;
+        }
+
+        /// Prepends only when there is free space; returns whether it did.
+        bool try_push_front(const value_type& _value)
+        {
+            if (finish == end_of_storage)
+                return false;
+            push_front(_value);
+            return true;
+        }
+
+        bool try_push_front(value_type&& _value)
+        {
+            if (finish == end_of_storage)
+                return false;
+            push_front(std::move(_value));
+            return true;
+        }
+
+        /// Moves the oldest element out, or nullopt when empty.
+        std::optional<value_type> try_pop_front()
+        {
+            if (empty())
+                return std::nullopt;
+            std::optional<value_type> value(std::move(*begin()));
+            pop_front();
+            return value;
+        }
+
+        /**
+         * @brief Appends _n elements from _src at once. When there is
+         *  not enough free space the oldest elements are overwritten
+         *  under OverflowPolicy::Overwrite, while under Reject only the
+         *  leading elements that fit are appended. For trivially
+         *  copyable types the data lands with at most two memcpy calls
+         *  over the physical segments.
+         */
+        void push_back_n(const_pointer _src, size_type _n)
+        {
+            const size_type cap = capacity();
+            if (!_n || !cap)
+                return;
+            if constexpr (std::is_trivially_copyable_v<Tp>) {
+                size_type n = _n;
+                size_type sz = size();
+                size_type head_idx = start - start_of_storage;
+                if constexpr (Policy == OverflowPolicy::Reject) {
+                    n = std::min(n, cap - sz);
+                    if (!n)
+                        return;
+                } else if (n >= cap) {
+                    _stat_overwrite(sz + n - cap);
+                    _src += n - cap;
+                    n = cap;
+                    sz = 0;
+                    head_idx = 0;
+                } else if (n > cap - sz) {
+                    const size_type dropped = n - (cap - sz);
+                    _stat_overwrite(dropped);
+                    sz -= dropped;
+                    head_idx = (head_idx + dropped) % cap;
+                }
+                const size_type write_idx = (head_idx + sz) % cap;
+                const size_type contiguous = std::min(n, cap - write_idx);
+                std::memcpy(start_of_storage + write_idx, _src, contiguous * sizeof(Tp));
+                std::memcpy(start_of_storage, _src + contiguous, (n - contiguous) * sizeof(Tp));
+                sz += n;
+                start = start_of_storage + head_idx;
+                finish = sz == cap ? end_of_storage : start_of_storage + (head_idx + sz) % cap;
+                count = sz;
+                _stat_occupancy();
+            } else {
+                for (size_type filled = 0; filled < _n; filled++) {
+                    push_back(_src[filled]);
+                }
+            }
+        }
+
+        void append(std::span<const value_type> _values)
+        {
+            push_back_n(_values.data(), _values.size());
+        }
+
+        /**
+         * @brief Moves up to _n oldest elements out into _dst and removes
+         *  them, advancing start once. Returns the number of elements
+         *  actually popped.
+         */
+        size_type pop_front_n(pointer _dst, size_type _n)
+        {
+            const size_type popped = std::min(_n, size());
+            if (!popped)
+                return 0;
+            if constexpr (std::is_trivially_copyable_v<Tp>) {
+                const size_type cap = capacity();
+                size_type sz = size();
+                size_type head_idx = start - start_of_storage;
+                const size_type contiguous = std::min(popped, cap - head_idx);
+                std::memcpy(_dst, start_of_storage + head_idx, contiguous * sizeof(Tp));
+                std::memcpy(_dst + contiguous, start_of_storage, (popped - contiguous) * sizeof(Tp));
+                sz -= popped;
+                head_idx = (head_idx + popped) % cap;
+                start = start_of_storage + head_idx;
+                finish = start_of_storage + (head_idx + sz) % cap;
+                count = sz;
+                _stat_occupancy();
+            } else {
+                for (size_type moved = 0; moved < popped; moved++) {
+                    _dst[moved] = std::move(front());
+                    pop_front();
+                }
+            }
+
+            return popped;
+        }
+
+        /**
+         * @brief Hands the oldest _n elements to _fn as at most two raw
+         *  contiguous [first, last) pointer ranges, destroys them in bulk
+         *  and advances start once. Returns the number of elements
+         *  consumed.
+         */
+        template<typename Fn>
+        size_type consume_n(size_type _n, Fn&& _fn)
+        {
+            const size_type consumed = std::min(_n, size());
+            if (!consumed)
+                return 0;
+            const size_type cap = capacity();
+            const size_type head_idx = start - start_of_storage;
+            const size_type contiguous = std::min(consumed, cap - head_idx);
+            _fn(start_of_storage + head_idx, start_of_storage + head_idx + contiguous);
+            if (consumed > contiguous)
+                _fn(start_of_storage, start_of_storage + (consumed - contiguous));
+            std::_Destroy(start_of_storage + head_idx, start_of_storage + head_idx + contiguous);
+            std::_Destroy(start_of_storage, start_of_storage + (consumed - contiguous));
+            if (finish == end_of_storage)
+                finish = start;
+            start = start_of_storage + (head_idx + consumed) % cap;
+            count -= consumed;
+            return consumed;
+        }
+
+        /// Drains the whole buffer through consume_n.
+        template<typename Fn>
+        size_type consume_all(Fn&& _fn)
+        {
+            return consume_n(size(), std::forward<Fn>(_fn));
+        }
+
+#ifdef __unix__
+        /**
+         * @brief Writes the buffered elements to _fd with a single
+         *  writev over the at-most-two physical segments and removes
+         *  the elements that were written out. Returns the number of
+         *  whole elements written, or -1 with errno set. Requires a
+         *  trivially copyable element type.
+         */
+        ssize_t write_to_fd(int _fd)
+        {
+            static_assert(std::is_trivially_copyable_v<Tp>,
+                          "write_to_fd requires a trivially copyable element type");
+            struct iovec iov[2];
+            int iovcnt = 0;
+            for (const auto& seg: segments())
+                if (seg.second)
+                    iov[iovcnt++] = {seg.first, seg.second * sizeof(Tp)};
+            if (!iovcnt)
+                return 0;
+            const ssize_t written = ::writev(_fd, iov, iovcnt);
+            if (written < 0)
+                return written;
+            const size_type whole = static_cast<size_type>(written) / sizeof(Tp);
+            if (whole && finish == end_of_storage)
+                finish = start;
+            const size_type head_idx = start - start_of_storage;
+            start = start_of_storage + (head_idx + whole) % capacity();
+            count -= whole;
+            return whole;
+        }
+
+        /**
+         * @brief Reads up to _max elements from _fd straight into the
+         *  free space with a single readv, no staging copy. Returns the
+         *  number of whole elements read, or -1 with errno set; the
+         *  bytes of a trailing partial element are dropped. Requires a
+         *  trivially copyable element type.
+         */
+        ssize_t read_from_fd(int _fd, size_type _max)
+        {
+            static_assert(std::is_trivially_copyable_v<Tp>,
+                          "read_from_fd requires a trivially copyable element type");
+            const size_type cap = capacity();
+            const size_type room = std::min(_max, cap - size());
+            if (!room)
+                return 0;
+            const size_type head_idx = start - start_of_storage;
+            const size_type write_idx = (head_idx + size()) % cap;
+            const size_type contiguous = std::min(room, cap - write_idx);
+            struct iovec iov[2];
+            int iovcnt = 1;
+            iov[0] = {start_of_storage + write_idx, contiguous * sizeof(Tp)};
+            if (room > contiguous)
+                iov[iovcnt++] = {start_of_storage, (room - contiguous) * sizeof(Tp)};
+            const ssize_t got = ::readv(_fd, iov, iovcnt);
+            if (got < 0)
+                return got;
+            const size_type whole = static_cast<size_type>(got) / sizeof(Tp);
+            count += whole;
+            finish = count == cap ? end_of_storage : start_of_storage + (head_idx + count) % cap;
+            _stat_occupancy();
+            return whole;
+        }
+#endif
+
+        /**
+         * @brief Checkpoints the buffer to _out as a small header
+         *  followed by the raw bytes of the at-most-two physical
+         *  segments, so the write is bounded by stream bandwidth
+         *  rather than per-element iteration. Requires a trivially
+         *  copyable element type.
+         */
+        void dump(std::ostream& _out) const
+        {
+            static_assert(std::is_trivially_copyable_v<Tp>,
+                          "dump requires a trivially copyable element type");
+            const CBuffDumpHeader header = {CBuffDumpHeader::MAGIC, sizeof(Tp), size(), capacity()};
+            _out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+            for (const auto& seg: segments())
+                if (seg.second)
+                    _out.write(reinterpret_cast<const char*>(seg.first), seg.second * sizeof(Tp));
+        }
+
+        /**
+         * @brief Replaces the contents with a checkpoint written by
+         *  dump(). The elements land in freshly allocated storage with
+         *  a single contiguous read and start reset to the beginning
+         *  of storage. Throws std::runtime_error when the header does
+         *  not match this element type or the stream is truncated.
+         */
+        void restore(std::istream& _in)
+        {
+            static_assert(std::is_trivially_copyable_v<Tp>,
+                          "restore requires a trivially copyable element type");
+            CBuffDumpHeader header{};
+            _in.read(reinterpret_cast<char*>(&header), sizeof(header));
+            if (!_in || header.magic != CBuffDumpHeader::MAGIC
+                    || header.element_size != sizeof(Tp)
+                    || header.count > header.capacity)
+                throw std::runtime_error("dump does not match this buffer type");
+            const pointer fresh = std::allocator_traits<allocator_type>::allocate(alloc, header.capacity);
+            _in.read(reinterpret_cast<char*>(fresh), header.count * sizeof(Tp));
+            if (!_in) {
+                std::allocator_traits<allocator_type>::deallocate(alloc, fresh, header.capacity);
+                throw std::runtime_error("dump is truncated");
+            }
+            clear();
+            start = start_of_storage = fresh;
+            end_of_storage = start_of_storage + header.capacity;
+            count = header.count;
+            finish = count == header.capacity ? end_of_storage : start_of_storage + count;
+        }
+
         void pop_back()
         {
             if (!empty()) {
                 std::_Destroy((--end()).get_ptr());
                 finish = (--end()).get_ptr();
+                count--;
             }
         }
 
@@ -522,42 +1078,29 @@ namespace addons {
         {
             if (!empty()) {
                 std::_Destroy(start);
-                start = (++begin()).get_ptr();
+                if (finish == end_of_storage)
+                    finish = start;
+                if (start + 1 == end_of_storage)
+                    _stat_wrap();
+                start = start + 1 == end_of_storage ? start_of_storage : start + 1;
+                count--;
             }
         }
 
         iterator erase(const_iterator _pos)
         {
-            std::_Destroy(_pos.get_ptr());
-            if (_pos - begin() >= end() - _pos) {
-                for (auto cur = begin(); cur != _pos; cur++) {
-                    std::swap(*cur, *(cur + 1));
-                }
-                if (finish == end_of_storage) {
-                    finish = (--end()).get_ptr();
-                } else {
-                    finish--;
-                }
-            } else {
-                const_iterator st_post = begin();
-                for (auto cur = *const_cast<iterator*>(&_pos); cur != st_post; cur--) {
-                    std::swap(*cur, *(cur - 1));
-                }
-                if (finish == end_of_storage) {
-                    finish = start;
-                    start = (++begin()).get_ptr();
-                } else {
-                    if (start != end_of_storage - 1) {
-                        finish = start;
-                        start++;
-                    }
-                    else {
-                        start = start_of_storage;
-                    }
-                }
-            }
+            const size_type p = _logical_index(_pos.get_ptr());
+            _close_gap(p, 1);
+            return empty() || p >= size() ? end() : begin() + p;
+        }
 
-            return _pos;
+        iterator erase(const_iterator _first, const_iterator _last)
+        {
+            const size_type p = _logical_index(_first.get_ptr());
+            const size_type k = _logical_index(_last.get_ptr()) - p;
+            if (k)
+                _close_gap(p, k);
+            return empty() || p >= size() ? end() : begin() + p;
         }
 
         void swap(CircularBuffer& _x) noexcept
@@ -566,204 +1109,489 @@ namespace addons {
             std::swap(finish, _x.finish);
             std::swap(start_of_storage, _x.start_of_storage);
             std::swap(end_of_storage, _x.end_of_storage);
-            std::swap(alloc, _x.alloc);
+            std::swap(count, _x.count);
+            if constexpr (std::allocator_traits<allocator_type>::propagate_on_container_swap::value)
+                std::swap(alloc, _x.alloc);
         }
 
         void clear() noexcept
         {
-            alloc.deallocate(start_of_storage, end_of_storage - start_of_storage);
+            std::allocator_traits<allocator_type>::deallocate(alloc, start_of_storage, end_of_storage - start_of_storage);
             start_of_storage = start = end_of_storage = finish = pointer();
+            count = 0;
+        }
+
+        /**
+         * @brief Clears the buffer like clear(), after first running
+         *  the element destructors split over _threads chunks of the
+         *  physical segments. Worth it only for huge buffers of
+         *  elements with real destructors; trivially destructible
+         *  types skip the destructor pass entirely.
+         */
+        void clear(size_type _threads)
+        {
+            if constexpr (!std::is_trivially_destructible_v<Tp>)
+                for (auto& seg: segments())
+                    _parallel_chunks(seg.first, seg.second, _threads,
+                                     [](pointer _first, size_type _count) {
+                                         std::_Destroy(_first, _first + _count);
+                                     });
+            clear();
         }
 
         // Friend operators for iterator
 
-        friend class CBuffIterator<pointer>;
+        friend class CBuffIterator<pointer, CircularBuffer>;
 
-        template<typename Ptr>
-        friend CBuffIterator<Ptr> operator+(const CBuffIterator<Ptr>& _it, CBuffIterator<Ptr>::difference_type _offset) noexcept;
+        template<typename Ptr, typename Cont>
+        friend CBuffIterator<Ptr, Cont> operator+(const CBuffIterator<Ptr, Cont>& _it, CBuffIterator<Ptr, Cont>::difference_type _offset) noexcept;
 
-        template<typename Ptr>
-        friend CBuffIterator<Ptr> operator+(CBuffIterator<Ptr>::difference_type _offset, CBuffIterator<Ptr> _it) noexcept;
+        template<typename Ptr, typename Cont>
+        friend CBuffIterator<Ptr, Cont> operator+(CBuffIterator<Ptr, Cont>::difference_type _offset, CBuffIterator<Ptr, Cont> _it) noexcept;
 
-        template<typename Ptr>
-        friend CBuffIterator<Ptr> operator-(CBuffIterator<Ptr> _it, CBuffIterator<Ptr>::difference_type _offset) noexcept;
+        template<typename Ptr, typename Cont>
+        friend CBuffIterator<Ptr, Cont> operator-(CBuffIterator<Ptr, Cont> _it, CBuffIterator<Ptr, Cont>::difference_type _offset) noexcept;
 
-        template<typename Ptr>
-        friend CBuffIterator<Ptr>::difference_type operator-(const CBuffIterator<Ptr>& _left, const CBuffIterator<Ptr>& _right) noexcept;
+        template<typename Ptr, typename Cont>
+        friend CBuffIterator<Ptr, Cont>::difference_type operator-(const CBuffIterator<Ptr, Cont>& _left, const CBuffIterator<Ptr, Cont>& _right) noexcept;
 
-        template<typename Ptr>
-        friend bool operator==(const CBuffIterator<Ptr>& _left, const CBuffIterator<Ptr>& _right) noexcept;
+        template<typename Ptr, typename Cont>
+        friend bool operator==(const CBuffIterator<Ptr, Cont>& _left, const CBuffIterator<Ptr, Cont>& _right) noexcept;
 
-        template<typename Ptr>
-        friend bool operator!=(const CBuffIterator<Ptr>& _left, const CBuffIterator<Ptr>& _right) noexcept;
+        template<typename Ptr, typename Cont>
+        friend bool operator!=(const CBuffIterator<Ptr, Cont>& _left, const CBuffIterator<Ptr, Cont>& _right) noexcept;
 
-        template<typename Ptr>
-        friend bool operator>(const CBuffIterator<Ptr>& _left, const CBuffIterator<Ptr>& _right) noexcept;
+        template<typename Ptr, typename Cont>
+        friend bool operator>(const CBuffIterator<Ptr, Cont>& _left, const CBuffIterator<Ptr, Cont>& _right) noexcept;
 
-        template<typename Ptr>
-        friend bool operator<(const CBuffIterator<Ptr>& _left, const CBuffIterator<Ptr>& _right) noexcept;
+        template<typename Ptr, typename Cont>
+        friend bool operator<(const CBuffIterator<Ptr, Cont>& _left, const CBuffIterator<Ptr, Cont>& _right) noexcept;
 
-        template<typename Ptr>
-        friend bool operator>=(const CBuffIterator<Ptr>& _left, const CBuffIterator<Ptr>& _right) noexcept;
+        template<typename Ptr, typename Cont>
+        friend bool operator>=(const CBuffIterator<Ptr, Cont>& _left, const CBuffIterator<Ptr, Cont>& _right) noexcept;
 
-        template<typename Ptr>
-        friend bool operator<=(const CBuffIterator<Ptr>& _left, const CBuffIterator<Ptr>& _right) noexcept;
+        template<typename Ptr, typename Cont>
+        friend bool operator<=(const CBuffIterator<Ptr, Cont>& _left, const CBuffIterator<Ptr, Cont>& _right) noexcept;
 
         // Self operators
 
-        friend bool operator==(const CircularBuffer& _left, const CircularBuffer& _right) noexcept
+    private:
+        /// Shared core of the equality operators: after the size
+        /// short-circuit, compares the overlapping physical runs of
+        /// both buffers chunk by chunk. Types whose object
+        /// representation is unique compare whole runs with memcmp.
+        static bool _equal(const CircularBuffer& _left, const CircularBuffer& _right) noexcept
         {
             if (_left.size() != _right.size())
                 return false;
-            auto it_left = _left.begin();
-            auto it_right = _right.begin();
-            for (; it_left < _left.end(); it_left++, it_right++)
-            {
-                if (*it_left != *it_right)
-                    return false;
+            const size_type lcap = _left.capacity();
+            const size_type rcap = _right.capacity();
+            const size_type lhead = _left.start - _left.start_of_storage;
+            const size_type rhead = _right.start - _right.start_of_storage;
+            size_type done = 0;
+            while (done < _left.size()) {
+                const size_type lphys = (lhead + done) % lcap;
+                const size_type rphys = (rhead + done) % rcap;
+                const size_type chunk = std::min(_left.size() - done,
+                                                 std::min(lcap - lphys, rcap - rphys));
+                const_pointer lptr = _left.start_of_storage + lphys;
+                const_pointer rptr = _right.start_of_storage + rphys;
+                if constexpr (std::has_unique_object_representations_v<Tp>) {
+                    if (std::memcmp(lptr, rptr, chunk * sizeof(Tp)))
+                        return false;
+                } else {
+                    for (size_type i = 0; i < chunk; i++)
+                        if (lptr[i] != rptr[i])
+                            return false;
+                }
+                done += chunk;
             }
 
             return true;
         }
 
+        /// Shared core of the ordering operators: the lexicographic
+        /// outcome as -1/0/1, computed over the overlapping physical
+        /// runs. Single-byte unsigned types compare whole runs with
+        /// memcmp.
+        static int _order(const CircularBuffer& _left, const CircularBuffer& _right) noexcept
+        {
+            const size_type common = std::min(_left.size(), _right.size());
+            const size_type lcap = _left.capacity();
+            const size_type rcap = _right.capacity();
+            const size_type lhead = _left.start - _left.start_of_storage;
+            const size_type rhead = _right.start - _right.start_of_storage;
+            size_type done = 0;
+            while (done < common) {
+                const size_type lphys = (lhead + done) % lcap;
+                const size_type rphys = (rhead + done) % rcap;
+                const size_type chunk = std::min(common - done,
+                                                 std::min(lcap - lphys, rcap - rphys));
+                const_pointer lptr = _left.start_of_storage + lphys;
+                const_pointer rptr = _right.start_of_storage + rphys;
+                if constexpr (std::is_same_v<Tp, std::byte>
+                              || (std::is_integral_v<Tp> && std::is_unsigned_v<Tp> && sizeof(Tp) == 1)) {
+                    const int cmp = std::memcmp(lptr, rptr, chunk);
+                    if (cmp)
+                        return cmp < 0 ? -1 : 1;
+                } else {
+                    for (size_type i = 0; i < chunk; i++) {
+                        if (lptr[i] < rptr[i])
+                            return -1;
+                        if (rptr[i] < lptr[i])
+                            return 1;
+                    }
+                }
+                done += chunk;
+            }
+            if (_left.size() == _right.size())
+                return 0;
+
+            return _left.size() < _right.size() ? -1 : 1;
+        }
+
+    public:
+        friend bool operator==(const CircularBuffer& _left, const CircularBuffer& _right) noexcept
+        {
+            return _equal(_left, _right);
+        }
+
         friend bool operator!=(const CircularBuffer& _left, const CircularBuffer& _right) noexcept
         {
-            if (_left.size() != _right.size())
-                return true;
-            auto it_left = _left.begin();
-            auto it_right = _right.begin();
-            for (; it_left < _left.end(); it_left++, it_right++)
-            {
-                if (*it_left != *it_right)
-                    return true;
-            }
+            return !_equal(_left, _right);
+        }
+
+        friend std::strong_ordering operator<=>(const CircularBuffer& _left, const CircularBuffer& _right) noexcept
+        {
+            const int cmp = _order(_left, _right);
+            if (cmp < 0)
+                return std::strong_ordering::less;
+            if (cmp > 0)
+                return std::strong_ordering::greater;
 
-            return false;
+            return std::strong_ordering::equal;
         }
 
         friend bool operator>(const CircularBuffer& _left, const CircularBuffer& _right) noexcept
         {
-            auto it_left = _left.begin();
-            auto it_right = _right.begin();
-            for (; it_left < _left.end() && it_right < _right.end(); it_left++, it_right++)
-            {
-                if (*it_left > *it_right)
-                    return true;
-                if (*it_left < *it_right)
-                    return false;
-            }
-
-            return _left.size() > _right.size();
+            return _order(_left, _right) > 0;
         }
 
         friend bool operator<(const CircularBuffer& _left, const CircularBuffer& _right) noexcept
         {
-            auto it_left = _left.begin();
-            auto it_right = _right.begin();
-            for (; it_left < _left.end() && it_right < _right.end(); ++it_left, ++it_right)
-            {
-                if (*it_left < *it_right)
-                    return true;
-                if (*it_left > *it_right)
-                    return false;
-            }
-
-            return _left.size() < _right.size();
+            return _order(_left, _right) < 0;
         }
 
         friend bool operator>=(const CircularBuffer& _left, const CircularBuffer& _right) noexcept
         {
-            auto it_left = _left.begin();
-            auto it_right = _right.begin();
-            for (; it_left < _left.end() && it_right < _right.end(); it_left++, it_right++)
-            {
-                if (*it_left > *it_right)
-                    return true;
-                if (*it_left < *it_right)
-                    return false;
-            }
-
-            return _left.size() >= _right.size();
+            return _order(_left, _right) >= 0;
         }
 
         friend bool operator<=(const CircularBuffer& _left, const CircularBuffer& _right) noexcept
         {
-            auto it_left = _left.begin();
-            auto it_right = _right.begin();
-            for (; it_left < _left.end() && it_right < _right.end(); it_left++, it_right++)
-            {
-                if (*it_left < *it_right)
-                    return true;
-                if (*it_left > *it_right)
-                    return false;
-            }
+            return _order(_left, _right) <= 0;
+        }
 
-            return _left.size() <= _right.size();
+#ifdef CIRCULARBUFFER_STATS
+        /// Counters collected since construction; only present when
+        /// compiled with CIRCULARBUFFER_STATS.
+        [[nodiscard]] const CBuffStats& stats() const noexcept
+        {
+            return stats_counters;
         }
+#endif
 
     private:
         // Additional methods
 
-        void _erase_ending(size_type _n)
+        // Instrumentation hooks; empty inline functions unless compiled
+        // with CIRCULARBUFFER_STATS, so the default hot path is unchanged.
+
+        void _stat_realloc(size_type _bytes) noexcept
         {
-            auto new_ending = end() - _n;
-            std::_Destroy(new_ending, end());
-            finish = new_ending.get_ptr();
+#ifdef CIRCULARBUFFER_STATS
+            stats_counters.reallocations++;
+            stats_counters.bytes_relocated += _bytes;
+#else
+            (void) _bytes;
+#endif
+        }
+
+        void _stat_wrap() noexcept
+        {
+#ifdef CIRCULARBUFFER_STATS
+            stats_counters.wrap_arounds++;
+#endif
+        }
+
+        void _stat_overwrite(size_type _n) noexcept
+        {
+#ifdef CIRCULARBUFFER_STATS
+            stats_counters.overwritten += _n;
+#else
+            (void) _n;
+#endif
+        }
+
+        void _stat_occupancy() noexcept
+        {
+#ifdef CIRCULARBUFFER_STATS
+            if (count > stats_counters.max_occupancy)
+                stats_counters.max_occupancy = count;
+#endif
+        }
+
+        void _erase_ending(size_type _n)
+
+        {
+            auto new_ending = end() - _n;
+            std::_Destroy(new_ending, end());
+            finish = new_ending.get_ptr();
+            count -= _n;
+        }
+
+        /**
+         * @brief Logical index of a position pointer: the forward
+         *  distance from start, with the end sentinel mapping to
+         *  size(). Unlike CBuffIterator subtraction this stays exact
+         *  for the arithmetic end position and for full wrapped
+         *  buffers, so insert and erase derive their indices here.
+         */
+        size_type _logical_index(const_pointer _ptr) const noexcept
+        {
+            if (_ptr == end_of_storage)
+                return size();
+            if (_ptr >= start)
+                return std::min<size_type>(_ptr - start, size());
+
+            return std::min<size_type>((end_of_storage - start) + (_ptr - start_of_storage), size());
+        }
+
+        /**
+         * @brief Opens a _n-slot gap at logical index _p by shifting the
+         *  smaller side of the buffer in place; no scratch storage is
+         *  involved. When the gap would exceed capacity the elements at
+         *  the far side are overwritten. Returns the logical index of
+         *  the gap relative to the adjusted start.
+         */
+        size_type _open_gap(size_type _p, size_type _n)
+        {
+            const size_type cap = capacity();
+            const size_type sz = size();
+            const pointer base = start_of_storage;
+            size_type head_idx = start - base;
+            const size_type dropped = sz + _n > cap ? sz + _n - cap : 0;
+            if (_p >= sz - _p) {
+                if constexpr (std::is_trivially_copyable_v<Tp>) {
+                    size_type i = sz;
+                    while (i > _p) {
+                        const size_type src = (head_idx + i - 1) % cap;
+                        const size_type dst = (head_idx + i - 1 + _n) % cap;
+                        const size_type len = std::min(std::min(i - _p, src + 1), dst + 1);
+                        std::memmove(base + dst + 1 - len, base + src + 1 - len, len * sizeof(Tp));
+                        i -= len;
+                    }
+                } else {
+                    for (size_type i = sz; i-- > _p;)
+                        base[(head_idx + i + _n) % cap] = std::move(base[(head_idx + i) % cap]);
+                }
+                count = sz + _n - dropped;
+                if (dropped)
+                    _stat_overwrite(dropped);
+                _stat_occupancy();
+                start = base + (head_idx + dropped) % cap;
+                head_idx = start - base;
+                finish = count == cap ? end_of_storage : base + (head_idx + count) % cap;
+                return _p >= dropped ? _p - dropped : 0;
+            }
+            const size_type new_head = (head_idx + cap - _n % cap) % cap;
+            if constexpr (std::is_trivially_copyable_v<Tp>) {
+                size_type i = 0;
+                while (i < _p) {
+                    const size_type src = (head_idx + i) % cap;
+                    const size_type dst = (new_head + i) % cap;
+                    const size_type len = std::min(std::min(_p - i, cap - src), cap - dst);
+                    std::memmove(base + dst, base + src, len * sizeof(Tp));
+                    i += len;
+                }
+            } else {
+                for (size_type i = 0; i < _p; i++)
+                    base[(new_head + i) % cap] = std::move(base[(head_idx + i) % cap]);
+            }
+            count = sz + _n - dropped;
+            if (dropped)
+                _stat_overwrite(dropped);
+            _stat_occupancy();
+            start = base + new_head;
+            finish = count == cap ? end_of_storage : base + (new_head + count) % cap;
+            return _p;
+        }
+
+        /**
+         * @brief Removes the _k-element window at logical index _p by
+         *  shifting the smaller surviving side of the buffer in place,
+         *  segment-wise. The vacated slots are destroyed the same way
+         *  pop_back and pop_front destroy theirs.
+         */
+        void _close_gap(size_type _p, size_type _k)
+        {
+            const size_type cap = capacity();
+            const size_type sz = size();
+            if (_p >= sz)
+                return;
+            _k = std::min(_k, sz - _p);
+            const pointer base = start_of_storage;
+            const size_type head_idx = start - base;
+            if (finish == end_of_storage)
+                finish = start;
+            if (_p <= sz - _p - _k) {
+                if constexpr (std::is_trivially_copyable_v<Tp>) {
+                    size_type i = _p;
+                    while (i > 0) {
+                        const size_type src = (head_idx + i - 1) % cap;
+                        const size_type dst = (head_idx + i - 1 + _k) % cap;
+                        const size_type len = std::min(std::min(i, src + 1), dst + 1);
+                        std::memmove(base + dst + 1 - len, base + src + 1 - len, len * sizeof(Tp));
+                        i -= len;
+                    }
+                } else {
+                    for (size_type i = _p; i-- > 0;)
+                        base[(head_idx + i + _k) % cap] = std::move(base[(head_idx + i) % cap]);
+                }
+                for (size_type i = 0; i < _k; i++)
+                    std::_Destroy(base + (head_idx + i) % cap);
+                start = base + (head_idx + _k) % cap;
+                count = sz - _k;
+                if (count == 0)
+                    finish = start;
+                return;
+            }
+            if constexpr (std::is_trivially_copyable_v<Tp>) {
+                size_type i = _p + _k;
+                while (i < sz) {
+                    const size_type src = (head_idx + i) % cap;
+                    const size_type dst = (head_idx + i - _k) % cap;
+                    const size_type len = std::min(std::min(sz - i, cap - src), cap - dst);
+                    std::memmove(base + dst, base + src, len * sizeof(Tp));
+                    i += len;
+                }
+            } else {
+                for (size_type i = _p + _k; i < sz; i++)
+                    base[(head_idx + i - _k) % cap] = std::move(base[(head_idx + i) % cap]);
+            }
+            for (size_type i = sz - _k; i < sz; i++)
+                std::_Destroy(base + (head_idx + i) % cap);
+            count = sz - _k;
+            finish = base + (head_idx + count) % cap;
+        }
+
+        /// Runs _fn(first, count) over up to _threads contiguous
+        /// chunks of [_first, _first + _n), each on its own thread;
+        /// falls back to a direct call for a single chunk.
+        template<typename Fn>
+        static void _parallel_chunks(pointer _first, size_type _n, size_type _threads, Fn&& _fn)
+        {
+            const size_type workers = std::min(_threads ? _threads : 1, _n ? _n : 1);
+            if (workers < 2) {
+                _fn(_first, _n);
+                return;
+            }
+            std::vector<std::thread> pool;
+            pool.reserve(workers);
+            const size_type chunk = _n / workers;
+            for (size_type cur = 0; cur < workers; cur++) {
+                pointer chunk_first = _first + cur * chunk;
+                const size_type chunk_count = cur + 1 == workers ? _n - cur * chunk : chunk;
+                pool.emplace_back([&_fn, chunk_first, chunk_count] { _fn(chunk_first, chunk_count); });
+            }
+            for (auto& worker: pool)
+                worker.join();
+        }
+
+        /// Relocates the first _n logical elements into _dst with one
+        /// memcpy per physical segment; only selected for trivially
+        /// relocatable types, whose source slots need no destruction.
+        pointer _relocate_segments(pointer _dst, size_type _n) noexcept
+        {
+            const size_type contiguous = std::min<size_type>(_n, end_of_storage - start);
+            std::memcpy(static_cast<void*>(_dst), static_cast<const void*>(start),
+                        contiguous * sizeof(Tp));
+            std::memcpy(static_cast<void*>(_dst + contiguous), static_cast<const void*>(start_of_storage),
+                        (_n - contiguous) * sizeof(Tp));
+
+            return _dst + _n;
         }
 
         void _reallocate_storage_default(size_type _new_size)
         {
+            _stat_realloc(std::min(size(), _new_size) * sizeof(Tp));
             if (_new_size >= size()) {
-                pointer new_start = alloc.allocate(_new_size);
+                pointer new_start = std::allocator_traits<allocator_type>::allocate(alloc, _new_size);
                 try {
                     std::__uninitialized_default_n_a(new_start + size(), _new_size - size(), alloc);
                 }
                 catch (...) {
-                    alloc.deallocate(new_start, _new_size);
+                    std::allocator_traits<allocator_type>::deallocate(alloc, new_start, _new_size);
                     throw std::length_error("allocator throw");
                 }
-                finish = std::__relocate_a(begin(),
-                                           end(),
-                                           new_start, alloc);
-                alloc.deallocate(start_of_storage, end_of_storage - start_of_storage);
+                if constexpr (is_trivially_relocatable_v<Tp>)
+                    finish = _relocate_segments(new_start, size());
+                else
+                    finish = std::__relocate_a(begin(),
+                                               end(),
+                                               new_start, alloc);
+                std::allocator_traits<allocator_type>::deallocate(alloc, start_of_storage, end_of_storage - start_of_storage);
                 start = start_of_storage = new_start;
                 end_of_storage = new_start + _new_size;
             } else {
-                pointer new_start = alloc.allocate(_new_size);
-                finish = std::__relocate_a(begin(),
-                                           begin() + _new_size,
-                                           new_start, alloc);
-                alloc.deallocate(start_of_storage, end_of_storage - start_of_storage);
+                pointer new_start = std::allocator_traits<allocator_type>::allocate(alloc, _new_size);
+                if constexpr (is_trivially_relocatable_v<Tp>)
+                    finish = _relocate_segments(new_start, _new_size);
+                else
+                    finish = std::__relocate_a(begin(),
+                                               begin() + _new_size,
+                                               new_start, alloc);
+                std::allocator_traits<allocator_type>::deallocate(alloc, start_of_storage, end_of_storage - start_of_storage);
                 start = start_of_storage = new_start;
                 end_of_storage = new_start + _new_size;
+                count = _new_size;
             }
         }
 
         void _reallocate_storage_filled(size_type _new_size, const value_type& _value)
         {
+            _stat_realloc(std::min(size(), _new_size) * sizeof(Tp));
             if (_new_size >= size()) {
-                pointer new_start = alloc.allocate(_new_size);
+                pointer new_start = std::allocator_traits<allocator_type>::allocate(alloc, _new_size);
                 try {
                     std::__uninitialized_fill_n_a(new_start + size(), _new_size - size(), _value, alloc);
                 }
                 catch (...) {
-                    alloc.deallocate(new_start, _new_size);
+                    std::allocator_traits<allocator_type>::deallocate(alloc, new_start, _new_size);
                     throw std::length_error("allocator throw");
                 }
-                std::__relocate_a(begin(),
-                                  end(),
-                                  new_start, alloc);
-                alloc.deallocate(start_of_storage, end_of_storage - start_of_storage);
+                if constexpr (is_trivially_relocatable_v<Tp>)
+                    _relocate_segments(new_start, size());
+                else
+                    std::__relocate_a(begin(),
+                                      end(),
+                                      new_start, alloc);
+                std::allocator_traits<allocator_type>::deallocate(alloc, start_of_storage, end_of_storage - start_of_storage);
                 start = start_of_storage = new_start;
                 finish = end_of_storage = new_start + _new_size;
+                count = _new_size;
             } else {
-                pointer new_start = alloc.allocate(_new_size);
-                finish = std::__relocate_a(begin(),
-                                           begin() + _new_size,
-                                           new_start, alloc);
-                alloc.deallocate(start_of_storage, end_of_storage - start_of_storage);
+                pointer new_start = std::allocator_traits<allocator_type>::allocate(alloc, _new_size);
+                if constexpr (is_trivially_relocatable_v<Tp>)
+                    finish = _relocate_segments(new_start, _new_size);
+                else
+                    finish = std::__relocate_a(begin(),
+                                               begin() + _new_size,
+                                               new_start, alloc);
+                std::allocator_traits<allocator_type>::deallocate(alloc, start_of_storage, end_of_storage - start_of_storage);
                 start = start_of_storage = new_start;
                 end_of_storage = new_start + _new_size;
+                count = _new_size;
             }
         }
     };
@@ -776,8 +1604,10 @@ namespace addons {
      * @ingroup iterators
      *
      * @tparam Ptr Pointer to element&
+     * @tparam Container Buffer class the iterator walks over.
+     *  Default - CircularBuffer of the pointed-to type.
      */
-    template<typename Ptr>
+    template<typename Ptr, typename Container>
     class CBuffIterator {
     public:
         typedef Ptr pointer;
@@ -785,7 +1615,7 @@ namespace addons {
         typedef std::iterator_traits<pointer>::value_type value_type;
         typedef std::iterator_traits<pointer>::reference reference;
         typedef std::iterator_traits<pointer>::difference_type difference_type;
-        typedef const CircularBuffer<value_type>* container_const_pointer;
+        typedef const Container* container_const_pointer;
 
     private:
         pointer stored_ptr;
@@ -810,7 +1640,7 @@ namespace addons {
             return *this;
         }
 
-        explicit CBuffIterator(pointer _ptr, const CircularBuffer<value_type>& _buf) noexcept
+        explicit CBuffIterator(pointer _ptr, const Container& _buf) noexcept
         : stored_ptr(_ptr), buffer(&_buf)
         {}
 
@@ -951,43 +1781,43 @@ namespace addons {
             return *this;
         }
 
-        template<typename InnerPtr>
-        friend CBuffIterator<InnerPtr> operator+(const CBuffIterator<InnerPtr>& _it, CBuffIterator<InnerPtr>::difference_type _offset) noexcept;
+        template<typename InnerPtr, typename Cont>
+        friend CBuffIterator<InnerPtr, Cont> operator+(const CBuffIterator<InnerPtr, Cont>& _it, CBuffIterator<InnerPtr, Cont>::difference_type _offset) noexcept;
 
-        template<typename InnerPtr>
-        friend CBuffIterator<InnerPtr> operator+(CBuffIterator<InnerPtr>::difference_type _offset, CBuffIterator<InnerPtr> _it) noexcept;
+        template<typename InnerPtr, typename Cont>
+        friend CBuffIterator<InnerPtr, Cont> operator+(CBuffIterator<InnerPtr, Cont>::difference_type _offset, CBuffIterator<InnerPtr, Cont> _it) noexcept;
 
-        template<typename InnerPtr>
-        friend CBuffIterator<InnerPtr> operator-(CBuffIterator<InnerPtr> _it, CBuffIterator<InnerPtr>::difference_type _offset) noexcept;
+        template<typename InnerPtr, typename Cont>
+        friend CBuffIterator<InnerPtr, Cont> operator-(CBuffIterator<InnerPtr, Cont> _it, CBuffIterator<InnerPtr, Cont>::difference_type _offset) noexcept;
 
         // Difference
 
-        template<typename InnerPtr>
-        friend CBuffIterator<InnerPtr>::difference_type operator-(const CBuffIterator<InnerPtr>& _left, const CBuffIterator<InnerPtr>& _right) noexcept;
+        template<typename InnerPtr, typename Cont>
+        friend CBuffIterator<InnerPtr, Cont>::difference_type operator-(const CBuffIterator<InnerPtr, Cont>& _left, const CBuffIterator<InnerPtr, Cont>& _right) noexcept;
 
         // Comparison
 
-        template<typename InnerPtr>
-        friend bool operator==(const CBuffIterator<InnerPtr>& _left, const CBuffIterator<InnerPtr>& _right) noexcept;
+        template<typename InnerPtr, typename Cont>
+        friend bool operator==(const CBuffIterator<InnerPtr, Cont>& _left, const CBuffIterator<InnerPtr, Cont>& _right) noexcept;
 
-        template<typename InnerPtr>
-        friend bool operator!=(const CBuffIterator<InnerPtr>& _left, const CBuffIterator<InnerPtr>& _right) noexcept;
+        template<typename InnerPtr, typename Cont>
+        friend bool operator!=(const CBuffIterator<InnerPtr, Cont>& _left, const CBuffIterator<InnerPtr, Cont>& _right) noexcept;
 
-        template<typename InnerPtr>
-        friend bool operator>(const CBuffIterator<InnerPtr>& _left, const CBuffIterator<InnerPtr>& _right) noexcept;
+        template<typename InnerPtr, typename Cont>
+        friend bool operator>(const CBuffIterator<InnerPtr, Cont>& _left, const CBuffIterator<InnerPtr, Cont>& _right) noexcept;
 
-        template<typename InnerPtr>
-        friend bool operator<(const CBuffIterator<InnerPtr>& _left, const CBuffIterator<InnerPtr>& _right) noexcept;
+        template<typename InnerPtr, typename Cont>
+        friend bool operator<(const CBuffIterator<InnerPtr, Cont>& _left, const CBuffIterator<InnerPtr, Cont>& _right) noexcept;
 
-        template<typename InnerPtr>
-        friend bool operator>=(const CBuffIterator<InnerPtr>& _left, const CBuffIterator<InnerPtr>& _right) noexcept;
+        template<typename InnerPtr, typename Cont>
+        friend bool operator>=(const CBuffIterator<InnerPtr, Cont>& _left, const CBuffIterator<InnerPtr, Cont>& _right) noexcept;
 
-        template<typename InnerPtr>
-        friend bool operator<=(const CBuffIterator<InnerPtr>& _left, const CBuffIterator<InnerPtr>& _right) noexcept;
+        template<typename InnerPtr, typename Cont>
+        friend bool operator<=(const CBuffIterator<InnerPtr, Cont>& _left, const CBuffIterator<InnerPtr, Cont>& _right) noexcept;
     };
 
-    template<typename Ptr>
-    CBuffIterator<Ptr> operator+(const CBuffIterator<Ptr>& _it, typename CBuffIterator<Ptr>::difference_type _offset) noexcept
+    template<typename Ptr, typename Cont>
+    CBuffIterator<Ptr, Cont> operator+(const CBuffIterator<Ptr, Cont>& _it, typename CBuffIterator<Ptr, Cont>::difference_type _offset) noexcept
     {
         auto new_it = CBuffIterator(_it);
         new_it.operator+=(_offset);
@@ -995,16 +1825,16 @@ namespace addons {
         return new_it;
     }
 
-    template<typename Ptr>
-    CBuffIterator<Ptr> operator+(typename CBuffIterator<Ptr>::difference_type _offset, CBuffIterator<Ptr> _it) noexcept
+    template<typename Ptr, typename Cont>
+    CBuffIterator<Ptr, Cont> operator+(typename CBuffIterator<Ptr, Cont>::difference_type _offset, CBuffIterator<Ptr, Cont> _it) noexcept
     {
         _it.operator+=(_offset);
 
         return _it;
     }
 
-    template<typename Ptr>
-    CBuffIterator<Ptr> operator-(CBuffIterator<Ptr> _it, typename CBuffIterator<Ptr>::difference_type _offset) noexcept
+    template<typename Ptr, typename Cont>
+    CBuffIterator<Ptr, Cont> operator-(CBuffIterator<Ptr, Cont> _it, typename CBuffIterator<Ptr, Cont>::difference_type _offset) noexcept
     {
         auto new_it = CBuffIterator(_it);
         new_it.operator-=(_offset);
@@ -1012,8 +1842,8 @@ namespace addons {
         return new_it;
     }
 
-    template<typename Ptr>
-    CBuffIterator<Ptr>::difference_type operator-(const CBuffIterator<Ptr>& _left, const CBuffIterator<Ptr>& _right) noexcept
+    template<typename Ptr, typename Cont>
+    CBuffIterator<Ptr, Cont>::difference_type operator-(const CBuffIterator<Ptr, Cont>& _left, const CBuffIterator<Ptr, Cont>& _right) noexcept
     {
         if (_left.buffer->start <= _left.buffer->finish
             || _left.stored_ptr <= _left.buffer->finish && _right.stored_ptr <= _left.buffer->finish
@@ -1027,20 +1857,20 @@ namespace addons {
                (_right.stored_ptr - _left.buffer->start_of_storage);
     }
 
-    template<typename Ptr>
-    bool operator==(const CBuffIterator<Ptr>& _left, const CBuffIterator<Ptr>& _right) noexcept
+    template<typename Ptr, typename Cont>
+    bool operator==(const CBuffIterator<Ptr, Cont>& _left, const CBuffIterator<Ptr, Cont>& _right) noexcept
     {
         return _left.stored_ptr == _right.stored_ptr;
     }
 
-    template<typename Ptr>
-    bool operator!=(const CBuffIterator<Ptr>& _left, const CBuffIterator<Ptr>& _right) noexcept
+    template<typename Ptr, typename Cont>
+    bool operator!=(const CBuffIterator<Ptr, Cont>& _left, const CBuffIterator<Ptr, Cont>& _right) noexcept
     {
         return _left.stored_ptr != _right.stored_ptr;
     }
 
-    template<typename Ptr>
-    bool operator>(const CBuffIterator<Ptr>& _left, const CBuffIterator<Ptr>& _right) noexcept
+    template<typename Ptr, typename Cont>
+    bool operator>(const CBuffIterator<Ptr, Cont>& _left, const CBuffIterator<Ptr, Cont>& _right) noexcept
     {
         if (_left.buffer->start <= _left.buffer->finish
             || _left.stored_ptr <= _left.buffer->finish && _right.stored_ptr <= _left.buffer->finish
@@ -1050,8 +1880,8 @@ namespace addons {
         return _left.stored_ptr < _right.stored_ptr;
     }
 
-    template<typename Ptr>
-    bool operator<(const CBuffIterator<Ptr>& _left, const CBuffIterator<Ptr>& _right) noexcept
+    template<typename Ptr, typename Cont>
+    bool operator<(const CBuffIterator<Ptr, Cont>& _left, const CBuffIterator<Ptr, Cont>& _right) noexcept
     {
         if (_left.buffer->start <= _left.buffer->finish
             || _left.stored_ptr <= _left.buffer->finish && _right.stored_ptr <= _left.buffer->finish
@@ -1061,8 +1891,8 @@ namespace addons {
         return _left.stored_ptr > _right.stored_ptr;
     }
 
-    template<typename Ptr>
-    bool operator>=(const CBuffIterator<Ptr>& _left, const CBuffIterator<Ptr>& _right) noexcept
+    template<typename Ptr, typename Cont>
+    bool operator>=(const CBuffIterator<Ptr, Cont>& _left, const CBuffIterator<Ptr, Cont>& _right) noexcept
     {
         if (_left.buffer->start <= _left.buffer->finish
             || _left.stored_ptr <= _left.buffer->finish && _right.stored_ptr <= _left.buffer->finish
@@ -1072,8 +1902,8 @@ namespace addons {
         return _left.stored_ptr <= _right.stored_ptr;
     }
 
-    template<typename Ptr>
-    bool operator<=(const CBuffIterator<Ptr>& _left, const CBuffIterator<Ptr>& _right) noexcept
+    template<typename Ptr, typename Cont>
+    bool operator<=(const CBuffIterator<Ptr, Cont>& _left, const CBuffIterator<Ptr, Cont>& _right) noexcept
     {
         if (_left.buffer->start <= _left.buffer->finish
             || _left.stored_ptr <= _left.buffer->finish && _right.stored_ptr <= _left.buffer->finish
@@ -1092,10 +1922,14 @@ namespace addons {
      *  @ingroup sequences
      *
      * @tparam Tp  Type of element. Default - default allocator.
+     * @tparam GrowthFactor  Capacity multiplier applied when the buffer
+     *  is full, so repeated push_back stays amortized O(1). Default - 2.
      *
      */
-    template<typename Tp, typename Alloc=std::allocator<Tp>>
+    template<typename Tp, typename Alloc=std::allocator<Tp>, size_t GrowthFactor=2>
     class CircularBufferExt {
+        static_assert(GrowthFactor >= 2, "growth factor lower than 2 makes push amortized O(n)");
+
     public:
         typedef Tp value_type;
         typedef Alloc allocator_type;
@@ -1103,58 +1937,113 @@ namespace addons {
         typedef const Tp* const_pointer;
         typedef Tp& reference;
         typedef const Tp& const_reference;
-        typedef CBuffIterator<pointer> iterator;
-        typedef const CBuffIterator<pointer> const_iterator;
+        typedef CBuffIterator<pointer, CircularBufferExt> iterator;
+        typedef const CBuffIterator<pointer, CircularBufferExt> const_iterator;
         typedef std::reverse_iterator<iterator> reverse_iterator;
         typedef std::reverse_iterator<const_iterator> const_reverse_iterator;
         typedef size_t size_type;
         typedef ptrdiff_t difference_type;
+        typedef std::pair<pointer, size_type> array_range;
+        typedef std::pair<const_pointer, size_type> const_array_range;
 
     private:
         pointer start;
         pointer finish;
         pointer start_of_storage;
         pointer end_of_storage;
+        size_type count;
         allocator_type alloc;
+#ifdef CIRCULARBUFFER_STATS
+        CBuffStats stats_counters{};
+#endif
 
     public:
         // Constructors / destructors / copy
 
         CircularBufferExt() noexcept
-            : start(), finish(), start_of_storage(), end_of_storage()
+            : start(), finish(), start_of_storage(), end_of_storage(), count()
         {}
 
         CircularBufferExt(const CircularBufferExt& _x) noexcept
+            : alloc(std::allocator_traits<allocator_type>::select_on_container_copy_construction(_x.alloc))
         {
-            start = start_of_storage = alloc.allocate(_x.capacity());
+            start = start_of_storage = std::allocator_traits<allocator_type>::allocate(alloc, _x.capacity());
             finish = start + _x.size();
             end_of_storage = start_of_storage + _x.capacity();
+            count = _x.size();
             std::__uninitialized_copy_a(_x.begin(), _x.end(), start, alloc);
         }
 
+        CircularBufferExt(CircularBufferExt&& _x) noexcept
+            : start(_x.start), finish(_x.finish), start_of_storage(_x.start_of_storage),
+              end_of_storage(_x.end_of_storage), count(_x.count),
+              alloc(std::move(_x.alloc))
+        {
+            _x.start_of_storage = _x.start = _x.end_of_storage = _x.finish = pointer();
+            _x.count = 0;
+        }
+
         CircularBufferExt(std::initializer_list<value_type> _list)
         {
-            start = start_of_storage = alloc.allocate(_list.size());
+            start = start_of_storage = std::allocator_traits<allocator_type>::allocate(alloc, _list.size());
             finish = end_of_storage = start + _list.size();
+            count = _list.size();
             std::__uninitialized_copy_a(_list.begin(), _list.end(), start, alloc);
         }
 
         CircularBufferExt& operator=(const CircularBufferExt& _x)
         {
             clear();
-            start = start_of_storage = alloc.allocate(_x.capacity());
+            if constexpr (std::allocator_traits<allocator_type>::propagate_on_container_copy_assignment::value)
+                alloc = _x.alloc;
+            start = start_of_storage = std::allocator_traits<allocator_type>::allocate(alloc, _x.capacity());
             finish = start + _x.size();
             end_of_storage = start_of_storage + _x.capacity();
+            count = _x.size();
             std::__uninitialized_copy_a(_x.begin(), _x.end(), start, alloc);
 
             return *this;
         }
 
+        CircularBufferExt& operator=(CircularBufferExt&& _x)
+            noexcept(std::allocator_traits<allocator_type>::propagate_on_container_move_assignment::value
+                     || std::allocator_traits<allocator_type>::is_always_equal::value)
+        {
+            clear();
+            if constexpr (std::allocator_traits<allocator_type>::propagate_on_container_move_assignment::value) {
+                alloc = std::move(_x.alloc);
+            } else if constexpr (!std::allocator_traits<allocator_type>::is_always_equal::value) {
+                if (alloc != _x.alloc) {
+                    // Storage from an incompatible allocator cannot be
+                    // adopted: allocate with ours and move the elements.
+                    start = start_of_storage = std::allocator_traits<allocator_type>::allocate(alloc, _x.capacity());
+                    finish = start + _x.size();
+                    end_of_storage = start_of_storage + _x.capacity();
+                    count = _x.size();
+                    std::__uninitialized_copy_a(std::make_move_iterator(_x.begin()),
+                                                std::make_move_iterator(_x.end()), start, alloc);
+                    _x.clear();
+
+                    return *this;
+                }
+            }
+            start = _x.start;
+            finish = _x.finish;
+            start_of_storage = _x.start_of_storage;
+            end_of_storage = _x.end_of_storage;
+            count = _x.count;
+            _x.start_of_storage = _x.start = _x.end_of_storage = _x.finish = pointer();
+            _x.count = 0;
+
+            return *this;
+        }
+
         CircularBufferExt& operator=(std::initializer_list<value_type> _list)
         {
             clear();
-            start = start_of_storage = alloc.allocate(_list.size());
+            start = start_of_storage = std::allocator_traits<allocator_type>::allocate(alloc, _list.size());
             finish = end_of_storage = start + _list.size();
+            count = _list.size();
             std::__uninitialized_copy_a(_list.begin(), _list.end(), start, alloc);
 
             return *this;
@@ -1162,20 +2051,41 @@ namespace addons {
 
         explicit CircularBufferExt(size_type _n)
         {
-            start = start_of_storage = finish = alloc.allocate(_n);
+            start = start_of_storage = finish = std::allocator_traits<allocator_type>::allocate(alloc, _n);
             end_of_storage = start_of_storage + _n;
+            count = 0;
         }
 
         explicit CircularBufferExt(size_type _n, const_reference _value)
         {
-            start = start_of_storage = alloc.allocate(_n);
+            start = start_of_storage = std::allocator_traits<allocator_type>::allocate(alloc, _n);
             end_of_storage = start_of_storage + _n;
             finish = std::__uninitialized_fill_n_a(start, _n, _value, alloc);
+            count = _n;
+        }
+
+        /**
+         * @brief Same as the filled constructor, but splits the fill
+         *  over _threads contiguous chunks constructed concurrently.
+         *  First-touching the pages from several threads also spreads
+         *  them across NUMA nodes. The element copy constructor must
+         *  not throw.
+         */
+        CircularBufferExt(size_type _n, const_reference _value, size_type _threads)
+        {
+            start = start_of_storage = std::allocator_traits<allocator_type>::allocate(alloc, _n);
+            end_of_storage = start_of_storage + _n;
+            _parallel_chunks(start_of_storage, _n, _threads,
+                             [this, &_value](pointer _first, size_type _count) {
+                                 std::__uninitialized_fill_n_a(_first, _count, _value, alloc);
+                             });
+            finish = end_of_storage;
+            count = _n;
         }
 
         template<typename InputIterator, typename = std::_RequireInputIter<InputIterator>>
         CircularBufferExt(InputIterator _first, InputIterator _last)
-            : start(), finish(), start_of_storage(), end_of_storage()
+            : start(), finish(), start_of_storage(), end_of_storage(), count()
         {
             assign(_first, _last);
         }
@@ -1285,16 +2195,12 @@ namespace addons {
 
         [[nodiscard]] bool empty() const noexcept
         {
-            return start == finish;
+            return count == 0;
         }
 
         [[nodiscard]] size_type size() const noexcept
         {
-            return start <= finish && finish != end_of_storage ?
-                   finish - start :
-                   finish != end_of_storage ?
-                   (finish - start_of_storage) + (end_of_storage - start) :
-                   end_of_storage - start_of_storage;
+            return count;
         }
 
         [[nodiscard]] size_type max_size() const noexcept
@@ -1314,10 +2220,12 @@ namespace addons {
             if (_new_size > max_size())
                 throw std::length_error("resizing overheads maximum size");
             if (_new_size > size()) {
-                if (_new_size > capacity())
+                if (_new_size > capacity()) {
                     _reallocate_storage_default(_new_size);
-                else
+                } else {
                     finish = std::__uninitialized_default_n_a(end(), _new_size - size(), alloc).get_ptr();
+                    count = _new_size;
+                }
             } else if (_new_size) {
                 _erase_ending(size() - _new_size);
             }
@@ -1328,10 +2236,12 @@ namespace addons {
             if (_new_size > max_size())
                 throw std::length_error("resizing overheads maximum size");
             if (_new_size > size()) {
-                if (_new_size > capacity())
+                if (_new_size > capacity()) {
                     _reallocate_storage_filled(_new_size, _value);
-                else
+                } else {
                     finish = std::__uninitialized_fill_n_a(end(), _new_size - size(), _value, alloc).get_ptr();
+                    count = _new_size;
+                }
             } else {
                 _erase_ending(size() - _new_size);
             }
@@ -1390,175 +2300,206 @@ namespace addons {
             return begin().at(_offset);
         }
 
+        /**
+         * @brief First physical contiguous run of elements, starting at
+         *  the logical front. {pointer, length}; length 0 when empty.
+         */
+        array_range array_one() noexcept
+        {
+            if (empty())
+                return array_range(start, 0);
+            if (finish == end_of_storage || finish < start)
+                return array_range(start, end_of_storage - start);
+            return array_range(start, finish - start);
+        }
+
+        const_array_range array_one() const noexcept
+        {
+            if (empty())
+                return const_array_range(start, 0);
+            if (finish == end_of_storage || finish < start)
+                return const_array_range(start, end_of_storage - start);
+            return const_array_range(start, finish - start);
+        }
+
+        /**
+         * @brief Second physical contiguous run, the part wrapped to the
+         *  beginning of storage. Length 0 when the content is one run.
+         */
+        array_range array_two() noexcept
+        {
+            if (empty())
+                return array_range(start_of_storage, 0);
+            if (finish == end_of_storage)
+                return array_range(start_of_storage, start - start_of_storage);
+            if (finish < start)
+                return array_range(start_of_storage, finish - start_of_storage);
+            return array_range(start_of_storage, 0);
+        }
+
+        const_array_range array_two() const noexcept
+        {
+            if (empty())
+                return const_array_range(start_of_storage, 0);
+            if (finish == end_of_storage)
+                return const_array_range(start_of_storage, start - start_of_storage);
+            if (finish < start)
+                return const_array_range(start_of_storage, finish - start_of_storage);
+            return const_array_range(start_of_storage, 0);
+        }
+
+        /**
+         * @brief Rotates storage so the content is a single contiguous
+         *  run starting at the beginning of storage. Returns a pointer
+         *  to the first element.
+         */
+        pointer linearize()
+        {
+            if (!empty() && array_two().second)
+                _reallocate_storage_default(capacity());
+            return start;
+        }
+
+        /**
+         * @brief Invokes _fn(first, last) with raw pointers over each of
+         *  the at-most-two contiguous runs, front run first. User loops
+         *  over the pointers compile to straight-line code the way
+         *  iteration through CBuffIterator cannot.
+         */
+        template<typename Fn>
+        void for_each_segment(Fn&& _fn)
+        {
+            const array_range one = array_one();
+            if (one.second)
+                _fn(one.first, one.first + one.second);
+            const array_range two = array_two();
+            if (two.second)
+                _fn(two.first, two.first + two.second);
+        }
+
+        template<typename Fn>
+        void for_each_segment(Fn&& _fn) const
+        {
+            const const_array_range one = array_one();
+            if (one.second)
+                _fn(one.first, one.first + one.second);
+            const const_array_range two = array_two();
+            if (two.second)
+                _fn(two.first, two.first + two.second);
+        }
+
+        /// Both physical runs as {pointer, length} pairs, front run first.
+        std::array<array_range, 2> segments() noexcept
+        {
+            return {array_one(), array_two()};
+        }
+
+        std::array<const_array_range, 2> segments() const noexcept
+        {
+            return {array_one(), array_two()};
+        }
+
         template<typename InputIterator, typename = std::_RequireInputIter<InputIterator>>
         void insert(iterator _pos, InputIterator _first, InputIterator _last)
         {
-            if (finish == end_of_storage)
-                resize(capacity() + _last - _first);
-            if (_pos - begin() >= end() - _pos) {
-                difference_type n_moved = end() - _pos;
-                pointer tmp = alloc.allocate(n_moved);
-                std::__relocate_a(_pos,
-                                  end(),
-                                  tmp, alloc);
-                auto cur = _pos;
-                for (; _first < _last; _first++, cur++) {
-                    if (cur == end()) {
-                        if (end().get_ptr() == end_of_storage) {
-                            cur = begin();
-                        } else {
-                            finish++;
-                            cur = --end();
-                        }
-                    }
-                    *cur = *_first;
-                }
-                const_pointer moved_end = tmp + n_moved;
-                for (; tmp < moved_end; tmp++, cur++) {
-                    if (end().get_ptr() == end_of_storage) {
-                        cur = begin();
-                    } else {
-                        finish++;
-                        cur = --end();
-                    }
-                    *cur = *tmp;
-                }
-                finish = cur.get_ptr();
-                alloc.deallocate(tmp, n_moved);
-            } else {
-                difference_type n_moved = end() - _pos;
-                pointer tmp = alloc.allocate(n_moved);
-                std::__relocate_a(reverse_iterator(_pos),
-                                  reverse_iterator(begin()),
-                                  tmp, alloc);
-                auto cur = reverse_iterator(_pos);
-                _first = std::reverse_iterator(_first);
-                _last = std::reverse_iterator(_last);
-                for (; _first < _last; _first++, cur++) {
-                    if (cur == begin()) {
-                        if (end().get_ptr() == end_of_storage) {
-                            cur = --end();
-                        } else {
-                            start--;
-                            cur = --begin();
-                        }
-                    }
-                    *cur = *_first;
-                }
-                const_pointer moved_end = tmp + n_moved;
-                for (; tmp < moved_end; tmp++, cur++) {
-                    if (cur == begin()) {
-                        if (end().get_ptr() == end_of_storage) {
-                            cur = --end();
-                        } else {
-                            start--;
-                            cur = --begin();
-                        }
-                    }
-                    *cur = *tmp;
-                }
-                start = (cur + 1).get_ptr();
-                alloc.deallocate(tmp, n_moved);
-            }
-        };
+            const size_type n = _last - _first;
+            if (n == 0)
+                return;
+            const size_type p = _logical_index(_pos.get_ptr());
+            if (size() + n > capacity())
+                reserve(_next_capacity(size() + n));
+            const size_type gap = _open_gap(p, n);
+            const size_type cap = capacity();
+            const size_type head_idx = start - start_of_storage;
+            for (size_type filled = 0; _first != _last; ++_first, filled++)
+                start_of_storage[(head_idx + gap + filled) % cap] = *_first;
+        }
 
         void insert(const_iterator _pos, size_type _n, const value_type& _value)
+        {
+            if (_n == 0)
+                return;
+            const size_type p = _logical_index(_pos.get_ptr());
+            if (size() + _n > capacity())
+                reserve(_next_capacity(size() + _n));
+            const size_type gap = _open_gap(p, _n);
+            const size_type cap = capacity();
+            const size_type head_idx = start - start_of_storage;
+            for (size_type filled = 0; filled < _n; filled++)
+                start_of_storage[(head_idx + gap + filled) % cap] = _value;
+        }
+
+        virtual void insert(const_iterator _pos, const value_type& _value)
         {
             if (finish == end_of_storage)
-                resize(capacity() + _n);
+                reserve(_next_capacity(size() + 1));
             if (_pos - begin() >= end() - _pos) {
-                difference_type n_moved = end() - _pos;
-                pointer tmp = alloc.allocate(n_moved);
-                std::__relocate_a(_pos,
-                                  end(),
-                                  tmp, alloc);
-                auto cur = _pos;
-                for (auto filled = 0; filled < _n; filled++, cur++) {
-                    if (cur == end()) {
-                        if (end().get_ptr() == end_of_storage) {
-                            cur = begin();
-                        } else {
-                            finish++;
-                            cur = --end();
-                        }
-                    }
-                    *cur = _value;
+                if (finish == end_of_storage) {
+                    start = (++begin()).get_ptr();
+                    _stat_overwrite(1);
+                } else {
+                    finish++;
+                    count++;
+                    _stat_occupancy();
                 }
-                const_pointer moved_end = tmp + n_moved;
-                for (; tmp < moved_end; tmp++, cur++) {
-                    if (end().get_ptr() == end_of_storage) {
-                        cur = begin();
-                    } else {
-                        finish++;
-                        cur = --end();
-                    }
-                    *cur = *tmp;
+                auto r_pos = const_reverse_iterator(_pos);
+                for (auto cur = rbegin(); cur != r_pos; cur++) {
+                    std::swap(*cur, *(cur + 1));
                 }
-                finish = cur.get_ptr();
-                alloc.deallocate(tmp, n_moved);
+                *_pos = _value;
             } else {
-                difference_type n_moved = end() - _pos;
-                pointer tmp = alloc.allocate(n_moved);
-                std::__relocate_a(const_reverse_iterator(_pos),
-                                  reverse_iterator(begin()),
-                                  tmp, alloc);
-                auto cur = *const_cast<iterator*>(&_pos);
-                for (auto filled = 0; filled < _n; filled++, --_pos) {
-                    if (cur == begin()) {
-                        if (end().get_ptr() == end_of_storage) {
-                            cur = --end();
-                        } else {
-                            start--;
-                            cur = --begin();
-                        }
-                    }
-                    *cur = _value;
+                if (finish == end_of_storage) {
+                    start = (--end()).get_ptr();
+                    _stat_overwrite(1);
+                } else {
+                    if (start != start_of_storage)
+                        start--;
+                    else
+                        start = end_of_storage - 1;
+                    count++;
+                    _stat_occupancy();
                 }
-                const_pointer moved_end = tmp + n_moved;
-                for (; tmp < moved_end; tmp++, cur++) {
-                    if (cur == begin()) {
-                        if (end().get_ptr() == end_of_storage) {
-                            cur = --end();
-                        } else {
-                            start--;
-                            cur = --begin();
-                        }
-                    }
-                    *cur = *tmp;
+                for (auto cur = begin(); cur != _pos - 1; ++cur) {
+                    std::swap(*cur, *(cur + 1));
                 }
-                start = (++cur).get_ptr();
-                alloc.deallocate(tmp, n_moved);
+                *(_pos - 1) = _value;
             }
-        };
+        }
 
-        virtual void insert(const_iterator _pos, const value_type& _value)
+        void insert(const_iterator _pos, value_type&& _value)
         {
             if (finish == end_of_storage)
-                resize(capacity() + 1);
+                reserve(_next_capacity(size() + 1));
             if (_pos - begin() >= end() - _pos) {
                 if (finish == end_of_storage) {
                     start = (++begin()).get_ptr();
+                    _stat_overwrite(1);
                 } else {
                     finish++;
+                    count++;
+                    _stat_occupancy();
                 }
                 auto r_pos = const_reverse_iterator(_pos);
                 for (auto cur = rbegin(); cur != r_pos; cur++) {
                     std::swap(*cur, *(cur + 1));
                 }
-                *_pos = _value;
+                *_pos = std::move(_value);
             } else {
                 if (finish == end_of_storage) {
                     start = (--end()).get_ptr();
+                    _stat_overwrite(1);
                 } else {
                     if (start != start_of_storage)
                         start--;
                     else
                         start = end_of_storage - 1;
+                    count++;
+                    _stat_occupancy();
                 }
                 for (auto cur = begin(); cur != _pos - 1; ++cur) {
                     std::swap(*cur, *(cur + 1));
                 }
-                *(_pos - 1) = _value;
+                *(_pos - 1) = std::move(_value);
             }
         }
 
@@ -1570,37 +2511,357 @@ namespace addons {
         void push_back(const value_type& _value)
         {
             if (finish == end_of_storage)
-                resize(capacity() + 1);
+                reserve(_next_capacity(size() + 1));
             if (finish == end_of_storage) {
                 *begin() = _value;
                 start = (++begin()).get_ptr();
+                _stat_overwrite(1);
             } else {
                 finish++;
+                count++;
+                _stat_occupancy();
+                if (finish == start)
+                    finish = end_of_storage;
                 *(--end()) = _value;
             }
         }
 
+        void push_back(value_type&& _value)
+        {
+            if (finish == end_of_storage)
+                reserve(_next_capacity(size() + 1));
+            if (finish == end_of_storage) {
+                *begin() = std::move(_value);
+                start = (++begin()).get_ptr();
+                _stat_overwrite(1);
+            } else {
+                finish++;
+                count++;
+                _stat_occupancy();
+                if (finish == start)
+                    finish = end_of_storage;
+                *(--end()) = std::move(_value);
+            }
+        }
+
         void push_front(const value_type& _value)
         {
             if (finish == end_of_storage)
-                resize(capacity() + 1);
+                reserve(_next_capacity(size() + 1));
             if (finish == end_of_storage) {
                 *(--end()) = _value;
                 start = (--end()).get_ptr();
+                _stat_overwrite(1);
             } else {
-                if (start != start_of_storage)
+                if (start != start_of_storage) {
                     start--;
-                else
+                } else {
                     start = end_of_storage - 1;
+                    _stat_wrap();
+                }
+                count++;
+                _stat_occupancy();
+                if (start == finish)
+                    finish = end_of_storage;
                 *begin() = _value;
             }
         }
 
+        void push_front(value_type&& _value)
+        {
+            if (finish == end_of_storage)
+                reserve(_next_capacity(size() + 1));
+            if (finish == end_of_storage) {
+                *(--end()) = std::move(_value);
+                start = (--end()).get_ptr();
+                _stat_overwrite(1);
+            } else {
+                if (start != start_of_storage) {
+                    start--;
+                } else {
+                    start = end_of_storage - 1;
+                    _stat_wrap();
+                }
+                count++;
+                _stat_occupancy();
+                if (start == finish)
+                    finish = end_of_storage;
+                *begin() = std::move(_value);
+            }
+        }
+
+        template<typename... Args>
+        reference emplace_back(Args&&... _args)
+        {
+            if (finish == end_of_storage)
+                reserve(_next_capacity(size() + 1));
+            if (finish == end_of_storage) {
+                *begin() = value_type(std::forward<Args>(_args)...);
+                start = (++begin()).get_ptr();
+                _stat_overwrite(1);
+            } else {
+                finish++;
+                count++;
+                _stat_occupancy();
+                if (finish == start)
+                    finish = end_of_storage;
+                pointer new_place = (--end()).get_ptr();
+                std::_Destroy(new_place);
+                std::allocator_traits<allocator_type>::construct(alloc, new_place, std::forward<Args>(_args)...);
+            }
+
+            return back();
+        }
+
+        template<typename... Args>
+        reference emplace_front(Args&&... _args)
+        {
+            if (finish == end_of_storage)
+                reserve(_next_capacity(size() + 1));
+            if (finish == end_of_storage) {
+                *(--end()) = value_type(std::forward<Args>(_args)...);
+                start = (--end()).get_ptr();
+                _stat_overwrite(1);
+            } else {
+                if (start != start_of_storage) {
+                    start--;
+                } else {
+                    start = end_of_storage - 1;
+                    _stat_wrap();
+                }
+                count++;
+                _stat_occupancy();
+                if (start == finish)
+                    finish = end_of_storage;
+                std::_Destroy(start);
+                std::allocator_traits<allocator_type>::construct(alloc, start, std::forward<Args>(_args)...);
+            }
+
+            return front();
+        }
+
+        /**
+         * @brief Appends _n elements from _src at once, growing the
+         *  buffer geometrically when needed. For trivially copyable
+         *  types the data lands with at most two memcpy calls over the
+         *  physical segments.
+         */
+        void push_back_n(const_pointer _src, size_type _n)
+        {
+            if (!_n)
+                return;
+            if (size() + _n > capacity())
+                reserve(_next_capacity(size() + _n));
+            if constexpr (std::is_trivially_copyable_v<Tp>) {
+                const size_type cap = capacity();
+                size_type sz = size();
+                const size_type head_idx = start - start_of_storage;
+                const size_type write_idx = (head_idx + sz) % cap;
+                const size_type contiguous = std::min(_n, cap - write_idx);
+                std::memcpy(start_of_storage + write_idx, _src, contiguous * sizeof(Tp));
+                std::memcpy(start_of_storage, _src + contiguous, (_n - contiguous) * sizeof(Tp));
+                sz += _n;
+                finish = sz == cap ? end_of_storage : start_of_storage + (head_idx + sz) % cap;
+                count = sz;
+                _stat_occupancy();
+            } else {
+                for (size_type filled = 0; filled < _n; filled++) {
+                    push_back(_src[filled]);
+                }
+            }
+        }
+
+        void append(std::span<const value_type> _values)
+        {
+            push_back_n(_values.data(), _values.size());
+        }
+
+        /**
+         * @brief Moves up to _n oldest elements out into _dst and removes
+         *  them, advancing start once. Returns the number of elements
+         *  actually popped.
+         */
+        size_type pop_front_n(pointer _dst, size_type _n)
+        {
+            const size_type popped = std::min(_n, size());
+            if (!popped)
+                return 0;
+            if constexpr (std::is_trivially_copyable_v<Tp>) {
+                const size_type cap = capacity();
+                size_type sz = size();
+                size_type head_idx = start - start_of_storage;
+                const size_type contiguous = std::min(popped, cap - head_idx);
+                std::memcpy(_dst, start_of_storage + head_idx, contiguous * sizeof(Tp));
+                std::memcpy(_dst + contiguous, start_of_storage, (popped - contiguous) * sizeof(Tp));
+                sz -= popped;
+                head_idx = (head_idx + popped) % cap;
+                start = start_of_storage + head_idx;
+                finish = start_of_storage + (head_idx + sz) % cap;
+                count = sz;
+                _stat_occupancy();
+            } else {
+                for (size_type moved = 0; moved < popped; moved++) {
+                    _dst[moved] = std::move(front());
+                    pop_front();
+                }
+            }
+
+            return popped;
+        }
+
+        /**
+         * @brief Hands the oldest _n elements to _fn as at most two raw
+         *  contiguous [first, last) pointer ranges, destroys them in bulk
+         *  and advances start once. Returns the number of elements
+         *  consumed.
+         */
+        template<typename Fn>
+        size_type consume_n(size_type _n, Fn&& _fn)
+        {
+            const size_type consumed = std::min(_n, size());
+            if (!consumed)
+                return 0;
+            const size_type cap = capacity();
+            const size_type head_idx = start - start_of_storage;
+            const size_type contiguous = std::min(consumed, cap - head_idx);
+            _fn(start_of_storage + head_idx, start_of_storage + head_idx + contiguous);
+            if (consumed > contiguous)
+                _fn(start_of_storage, start_of_storage + (consumed - contiguous));
+            std::_Destroy(start_of_storage + head_idx, start_of_storage + head_idx + contiguous);
+            std::_Destroy(start_of_storage, start_of_storage + (consumed - contiguous));
+            if (finish == end_of_storage)
+                finish = start;
+            start = start_of_storage + (head_idx + consumed) % cap;
+            count -= consumed;
+            return consumed;
+        }
+
+        /// Drains the whole buffer through consume_n.
+        template<typename Fn>
+        size_type consume_all(Fn&& _fn)
+        {
+            return consume_n(size(), std::forward<Fn>(_fn));
+        }
+
+#ifdef __unix__
+        /**
+         * @brief Writes the buffered elements to _fd with a single
+         *  writev over the at-most-two physical segments and removes
+         *  the elements that were written out. Returns the number of
+         *  whole elements written, or -1 with errno set. Requires a
+         *  trivially copyable element type.
+         */
+        ssize_t write_to_fd(int _fd)
+        {
+            static_assert(std::is_trivially_copyable_v<Tp>,
+                          "write_to_fd requires a trivially copyable element type");
+            struct iovec iov[2];
+            int iovcnt = 0;
+            for (const auto& seg: segments())
+                if (seg.second)
+                    iov[iovcnt++] = {seg.first, seg.second * sizeof(Tp)};
+            if (!iovcnt)
+                return 0;
+            const ssize_t written = ::writev(_fd, iov, iovcnt);
+            if (written < 0)
+                return written;
+            const size_type whole = static_cast<size_type>(written) / sizeof(Tp);
+            if (whole && finish == end_of_storage)
+                finish = start;
+            const size_type head_idx = start - start_of_storage;
+            start = start_of_storage + (head_idx + whole) % capacity();
+            count -= whole;
+            return whole;
+        }
+
+        /**
+         * @brief Reads up to _max elements from _fd straight into the
+         *  free space with a single readv, no staging copy. Returns the
+         *  number of whole elements read, or -1 with errno set; the
+         *  bytes of a trailing partial element are dropped. Requires a
+         *  trivially copyable element type.
+         */
+        ssize_t read_from_fd(int _fd, size_type _max)
+        {
+            static_assert(std::is_trivially_copyable_v<Tp>,
+                          "read_from_fd requires a trivially copyable element type");
+            const size_type cap = capacity();
+            const size_type room = std::min(_max, cap - size());
+            if (!room)
+                return 0;
+            const size_type head_idx = start - start_of_storage;
+            const size_type write_idx = (head_idx + size()) % cap;
+            const size_type contiguous = std::min(room, cap - write_idx);
+            struct iovec iov[2];
+            int iovcnt = 1;
+            iov[0] = {start_of_storage + write_idx, contiguous * sizeof(Tp)};
+            if (room > contiguous)
+                iov[iovcnt++] = {start_of_storage, (room - contiguous) * sizeof(Tp)};
+            const ssize_t got = ::readv(_fd, iov, iovcnt);
+            if (got < 0)
+                return got;
+            const size_type whole = static_cast<size_type>(got) / sizeof(Tp);
+            count += whole;
+            finish = count == cap ? end_of_storage : start_of_storage + (head_idx + count) % cap;
+            _stat_occupancy();
+            return whole;
+        }
+#endif
+
+        /**
+         * @brief Checkpoints the buffer to _out as a small header
+         *  followed by the raw bytes of the at-most-two physical
+         *  segments, so the write is bounded by stream bandwidth
+         *  rather than per-element iteration. Requires a trivially
+         *  copyable element type.
+         */
+        void dump(std::ostream& _out) const
+        {
+            static_assert(std::is_trivially_copyable_v<Tp>,
+                          "dump requires a trivially copyable element type");
+            const CBuffDumpHeader header = {CBuffDumpHeader::MAGIC, sizeof(Tp), size(), capacity()};
+            _out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+            for (const auto& seg: segments())
+                if (seg.second)
+                    _out.write(reinterpret_cast<const char*>(seg.first), seg.second * sizeof(Tp));
+        }
+
+        /**
+         * @brief Replaces the contents with a checkpoint written by
+         *  dump(). The elements land in freshly allocated storage with
+         *  a single contiguous read and start reset to the beginning
+         *  of storage. Throws std::runtime_error when the header does
+         *  not match this element type or the stream is truncated.
+         */
+        void restore(std::istream& _in)
+        {
+            static_assert(std::is_trivially_copyable_v<Tp>,
+                          "restore requires a trivially copyable element type");
+            CBuffDumpHeader header{};
+            _in.read(reinterpret_cast<char*>(&header), sizeof(header));
+            if (!_in || header.magic != CBuffDumpHeader::MAGIC
+                    || header.element_size != sizeof(Tp)
+                    || header.count > header.capacity)
+                throw std::runtime_error("dump does not match this buffer type");
+            const pointer fresh = std::allocator_traits<allocator_type>::allocate(alloc, header.capacity);
+            _in.read(reinterpret_cast<char*>(fresh), header.count * sizeof(Tp));
+            if (!_in) {
+                std::allocator_traits<allocator_type>::deallocate(alloc, fresh, header.capacity);
+                throw std::runtime_error("dump is truncated");
+            }
+            clear();
+            start = start_of_storage = fresh;
+            end_of_storage = start_of_storage + header.capacity;
+            count = header.count;
+            finish = count == header.capacity ? end_of_storage : start_of_storage + count;
+        }
+
         void pop_back()
         {
             if (!empty()) {
                 std::_Destroy((--end()).get_ptr());
                 finish = (--end()).get_ptr();
+                count--;
             }
         }
 
@@ -1608,42 +2869,29 @@ namespace addons {
         {
             if (!empty()) {
                 std::_Destroy(start);
-                start = (++begin()).get_ptr();
+                if (finish == end_of_storage)
+                    finish = start;
+                if (start + 1 == end_of_storage)
+                    _stat_wrap();
+                start = start + 1 == end_of_storage ? start_of_storage : start + 1;
+                count--;
             }
         }
 
         iterator erase(const_iterator _pos)
         {
-            std::_Destroy(_pos.get_ptr());
-            if (_pos - begin() >= end() - _pos) {
-                for (auto cur = begin(); cur != _pos; cur++) {
-                    std::swap(*cur, *(cur + 1));
-                }
-                if (finish == end_of_storage) {
-                    finish = (--end()).get_ptr();
-                } else {
-                    finish--;
-                }
-            } else {
-                const_iterator st_post = begin();
-                for (auto cur = *const_cast<iterator*>(&_pos); cur != st_post; cur--) {
-                    std::swap(*cur, *(cur - 1));
-                }
-                if (finish == end_of_storage) {
-                    finish = start;
-                    start = (++begin()).get_ptr();
-                } else {
-                    if (start != end_of_storage - 1) {
-                        finish = start;
-                        start++;
-                    }
-                    else {
-                        start = start_of_storage;
-                    }
-                }
-            }
+            const size_type p = _logical_index(_pos.get_ptr());
+            _close_gap(p, 1);
+            return empty() || p >= size() ? end() : begin() + p;
+        }
 
-            return _pos;
+        iterator erase(const_iterator _first, const_iterator _last)
+        {
+            const size_type p = _logical_index(_first.get_ptr());
+            const size_type k = _logical_index(_last.get_ptr()) - p;
+            if (k)
+                _close_gap(p, k);
+            return empty() || p >= size() ? end() : begin() + p;
         }
 
         void swap(CircularBufferExt& _x) noexcept
@@ -1652,204 +2900,495 @@ namespace addons {
             std::swap(finish, _x.finish);
             std::swap(start_of_storage, _x.start_of_storage);
             std::swap(end_of_storage, _x.end_of_storage);
-            std::swap(alloc, _x.alloc);
+            std::swap(count, _x.count);
+            if constexpr (std::allocator_traits<allocator_type>::propagate_on_container_swap::value)
+                std::swap(alloc, _x.alloc);
         }
 
         void clear() noexcept
         {
-            alloc.deallocate(start_of_storage, end_of_storage - start_of_storage);
+            std::allocator_traits<allocator_type>::deallocate(alloc, start_of_storage, end_of_storage - start_of_storage);
             start_of_storage = start = end_of_storage = finish = pointer();
+            count = 0;
+        }
+
+        /**
+         * @brief Clears the buffer like clear(), after first running
+         *  the element destructors split over _threads chunks of the
+         *  physical segments. Worth it only for huge buffers of
+         *  elements with real destructors; trivially destructible
+         *  types skip the destructor pass entirely.
+         */
+        void clear(size_type _threads)
+        {
+            if constexpr (!std::is_trivially_destructible_v<Tp>)
+                for (auto& seg: segments())
+                    _parallel_chunks(seg.first, seg.second, _threads,
+                                     [](pointer _first, size_type _count) {
+                                         std::_Destroy(_first, _first + _count);
+                                     });
+            clear();
         }
 
         // Friend operators for iterator
 
-        friend class CBuffIterator<pointer>;
+        friend class CBuffIterator<pointer, CircularBufferExt>;
 
-        template<typename Ptr>
-        friend CBuffIterator<Ptr> operator+(const CBuffIterator<Ptr>& _it, CBuffIterator<Ptr>::difference_type _offset) noexcept;
+        template<typename Ptr, typename Cont>
+        friend CBuffIterator<Ptr, Cont> operator+(const CBuffIterator<Ptr, Cont>& _it, CBuffIterator<Ptr, Cont>::difference_type _offset) noexcept;
 
-        template<typename Ptr>
-        friend CBuffIterator<Ptr> operator+(CBuffIterator<Ptr>::difference_type _offset, CBuffIterator<Ptr> _it) noexcept;
+        template<typename Ptr, typename Cont>
+        friend CBuffIterator<Ptr, Cont> operator+(CBuffIterator<Ptr, Cont>::difference_type _offset, CBuffIterator<Ptr, Cont> _it) noexcept;
 
-        template<typename Ptr>
-        friend CBuffIterator<Ptr> operator-(CBuffIterator<Ptr> _it, CBuffIterator<Ptr>::difference_type _offset) noexcept;
+        template<typename Ptr, typename Cont>
+        friend CBuffIterator<Ptr, Cont> operator-(CBuffIterator<Ptr, Cont> _it, CBuffIterator<Ptr, Cont>::difference_type _offset) noexcept;
 
-        template<typename Ptr>
-        friend CBuffIterator<Ptr>::difference_type operator-(const CBuffIterator<Ptr>& _left, const CBuffIterator<Ptr>& _right) noexcept;
+        template<typename Ptr, typename Cont>
+        friend CBuffIterator<Ptr, Cont>::difference_type operator-(const CBuffIterator<Ptr, Cont>& _left, const CBuffIterator<Ptr, Cont>& _right) noexcept;
 
-        template<typename Ptr>
-        friend bool operator==(const CBuffIterator<Ptr>& _left, const CBuffIterator<Ptr>& _right) noexcept;
+        template<typename Ptr, typename Cont>
+        friend bool operator==(const CBuffIterator<Ptr, Cont>& _left, const CBuffIterator<Ptr, Cont>& _right) noexcept;
 
-        template<typename Ptr>
-        friend bool operator!=(const CBuffIterator<Ptr>& _left, const CBuffIterator<Ptr>& _right) noexcept;
+        template<typename Ptr, typename Cont>
+        friend bool operator!=(const CBuffIterator<Ptr, Cont>& _left, const CBuffIterator<Ptr, Cont>& _right) noexcept;
 
-        template<typename Ptr>
-        friend bool operator>(const CBuffIterator<Ptr>& _left, const CBuffIterator<Ptr>& _right) noexcept;
+        template<typename Ptr, typename Cont>
+        friend bool operator>(const CBuffIterator<Ptr, Cont>& _left, const CBuffIterator<Ptr, Cont>& _right) noexcept;
 
-        template<typename Ptr>
-        friend bool operator<(const CBuffIterator<Ptr>& _left, const CBuffIterator<Ptr>& _right) noexcept;
+        template<typename Ptr, typename Cont>
+        friend bool operator<(const CBuffIterator<Ptr, Cont>& _left, const CBuffIterator<Ptr, Cont>& _right) noexcept;
 
-        template<typename Ptr>
-        friend bool operator>=(const CBuffIterator<Ptr>& _left, const CBuffIterator<Ptr>& _right) noexcept;
+        template<typename Ptr, typename Cont>
+        friend bool operator>=(const CBuffIterator<Ptr, Cont>& _left, const CBuffIterator<Ptr, Cont>& _right) noexcept;
 
-        template<typename Ptr>
-        friend bool operator<=(const CBuffIterator<Ptr>& _left, const CBuffIterator<Ptr>& _right) noexcept;
+        template<typename Ptr, typename Cont>
+        friend bool operator<=(const CBuffIterator<Ptr, Cont>& _left, const CBuffIterator<Ptr, Cont>& _right) noexcept;
 
         // Self operators
 
-        friend bool operator==(const CircularBufferExt& _left, const CircularBufferExt& _right) noexcept
+    private:
+        /// Shared core of the equality operators: after the size
+        /// short-circuit, compares the overlapping physical runs of
+        /// both buffers chunk by chunk. Types whose object
+        /// representation is unique compare whole runs with memcmp.
+        static bool _equal(const CircularBufferExt& _left, const CircularBufferExt& _right) noexcept
         {
             if (_left.size() != _right.size())
                 return false;
-            auto it_left = _left.begin();
-            auto it_right = _right.begin();
-            for (; it_left < _left.end(); it_left++, it_right++)
-            {
-                if (*it_left != *it_right)
-                    return false;
+            const size_type lcap = _left.capacity();
+            const size_type rcap = _right.capacity();
+            const size_type lhead = _left.start - _left.start_of_storage;
+            const size_type rhead = _right.start - _right.start_of_storage;
+            size_type done = 0;
+            while (done < _left.size()) {
+                const size_type lphys = (lhead + done) % lcap;
+                const size_type rphys = (rhead + done) % rcap;
+                const size_type chunk = std::min(_left.size() - done,
+                                                 std::min(lcap - lphys, rcap - rphys));
+                const_pointer lptr = _left.start_of_storage + lphys;
+                const_pointer rptr = _right.start_of_storage + rphys;
+                if constexpr (std::has_unique_object_representations_v<Tp>) {
+                    if (std::memcmp(lptr, rptr, chunk * sizeof(Tp)))
+                        return false;
+                } else {
+                    for (size_type i = 0; i < chunk; i++)
+                        if (lptr[i] != rptr[i])
+                            return false;
+                }
+                done += chunk;
             }
 
             return true;
         }
 
+        /// Shared core of the ordering operators: the lexicographic
+        /// outcome as -1/0/1, computed over the overlapping physical
+        /// runs. Single-byte unsigned types compare whole runs with
+        /// memcmp.
+        static int _order(const CircularBufferExt& _left, const CircularBufferExt& _right) noexcept
+        {
+            const size_type common = std::min(_left.size(), _right.size());
+            const size_type lcap = _left.capacity();
+            const size_type rcap = _right.capacity();
+            const size_type lhead = _left.start - _left.start_of_storage;
+            const size_type rhead = _right.start - _right.start_of_storage;
+            size_type done = 0;
+            while (done < common) {
+                const size_type lphys = (lhead + done) % lcap;
+                const size_type rphys = (rhead + done) % rcap;
+                const size_type chunk = std::min(common - done,
+                                                 std::min(lcap - lphys, rcap - rphys));
+                const_pointer lptr = _left.start_of_storage + lphys;
+                const_pointer rptr = _right.start_of_storage + rphys;
+                if constexpr (std::is_same_v<Tp, std::byte>
+                              || (std::is_integral_v<Tp> && std::is_unsigned_v<Tp> && sizeof(Tp) == 1)) {
+                    const int cmp = std::memcmp(lptr, rptr, chunk);
+                    if (cmp)
+                        return cmp < 0 ? -1 : 1;
+                } else {
+                    for (size_type i = 0; i < chunk; i++) {
+                        if (lptr[i] < rptr[i])
+                            return -1;
+                        if (rptr[i] < lptr[i])
+                            return 1;
+                    }
+                }
+                done += chunk;
+            }
+            if (_left.size() == _right.size())
+                return 0;
+
+            return _left.size() < _right.size() ? -1 : 1;
+        }
+
+    public:
+        friend bool operator==(const CircularBufferExt& _left, const CircularBufferExt& _right) noexcept
+        {
+            return _equal(_left, _right);
+        }
+
         friend bool operator!=(const CircularBufferExt& _left, const CircularBufferExt& _right) noexcept
         {
-            if (_left.size() != _right.size())
-                return true;
-            auto it_left = _left.begin();
-            auto it_right = _right.begin();
-            for (; it_left < _left.end(); it_left++, it_right++)
-            {
-                if (*it_left != *it_right)
-                    return true;
-            }
+            return !_equal(_left, _right);
+        }
+
+        friend std::strong_ordering operator<=>(const CircularBufferExt& _left, const CircularBufferExt& _right) noexcept
+        {
+            const int cmp = _order(_left, _right);
+            if (cmp < 0)
+                return std::strong_ordering::less;
+            if (cmp > 0)
+                return std::strong_ordering::greater;
 
-            return false;
+            return std::strong_ordering::equal;
         }
 
         friend bool operator>(const CircularBufferExt& _left, const CircularBufferExt& _right) noexcept
         {
-            auto it_left = _left.begin();
-            auto it_right = _right.begin();
-            for (; it_left < _left.end() && it_right < _right.end(); it_left++, it_right++)
-            {
-                if (*it_left > *it_right)
-                    return true;
-                if (*it_left < *it_right)
-                    return false;
-            }
-
-            return _left.size() > _right.size();
+            return _order(_left, _right) > 0;
         }
 
         friend bool operator<(const CircularBufferExt& _left, const CircularBufferExt& _right) noexcept
         {
-            auto it_left = _left.begin();
-            auto it_right = _right.begin();
-            for (; it_left < _left.end() && it_right < _right.end(); ++it_left, ++it_right)
-            {
-                if (*it_left < *it_right)
-                    return true;
-                if (*it_left > *it_right)
-                    return false;
-            }
-
-            return _left.size() < _right.size();
+            return _order(_left, _right) < 0;
         }
 
         friend bool operator>=(const CircularBufferExt& _left, const CircularBufferExt& _right) noexcept
         {
-            auto it_left = _left.begin();
-            auto it_right = _right.begin();
-            for (; it_left < _left.end() && it_right < _right.end(); it_left++, it_right++)
-            {
-                if (*it_left > *it_right)
-                    return true;
-                if (*it_left < *it_right)
-                    return false;
-            }
-
-            return _left.size() >= _right.size();
+            return _order(_left, _right) >= 0;
         }
 
         friend bool operator<=(const CircularBufferExt& _left, const CircularBufferExt& _right) noexcept
         {
-            auto it_left = _left.begin();
-            auto it_right = _right.begin();
-            for (; it_left < _left.end() && it_right < _right.end(); it_left++, it_right++)
-            {
-                if (*it_left < *it_right)
-                    return true;
-                if (*it_left > *it_right)
-                    return false;
-            }
+            return _order(_left, _right) <= 0;
+        }
 
-            return _left.size() <= _right.size();
+#ifdef CIRCULARBUFFER_STATS
+        /// Counters collected since construction; only present when
+        /// compiled with CIRCULARBUFFER_STATS.
+        [[nodiscard]] const CBuffStats& stats() const noexcept
+        {
+            return stats_counters;
         }
+#endif
 
     private:
         // Additional methods
 
+        // Instrumentation hooks; empty inline functions unless compiled
+        // with CIRCULARBUFFER_STATS, so the default hot path is unchanged.
+
+        void _stat_realloc(size_type _bytes) noexcept
+        {
+#ifdef CIRCULARBUFFER_STATS
+            stats_counters.reallocations++;
+            stats_counters.bytes_relocated += _bytes;
+#else
+            (void) _bytes;
+#endif
+        }
+
+        void _stat_wrap() noexcept
+        {
+#ifdef CIRCULARBUFFER_STATS
+            stats_counters.wrap_arounds++;
+#endif
+        }
+
+        void _stat_overwrite(size_type _n) noexcept
+        {
+#ifdef CIRCULARBUFFER_STATS
+            stats_counters.overwritten += _n;
+#else
+            (void) _n;
+#endif
+        }
+
+        void _stat_occupancy() noexcept
+        {
+#ifdef CIRCULARBUFFER_STATS
+            if (count > stats_counters.max_occupancy)
+                stats_counters.max_occupancy = count;
+#endif
+        }
+
+        [[nodiscard]] size_type _next_capacity(size_type _required) const noexcept
+        {
+            const size_type grown = capacity() * GrowthFactor;
+            return grown < _required ? _required : grown;
+        }
+
         void _erase_ending(size_type _n)
+
         {
             auto new_ending = end() - _n;
             std::_Destroy(new_ending, end());
             finish = new_ending.get_ptr();
+            count -= _n;
+        }
+
+        /**
+         * @brief Logical index of a position pointer: the forward
+         *  distance from start, with the end sentinel mapping to
+         *  size(). Unlike CBuffIterator subtraction this stays exact
+         *  for the arithmetic end position and for full wrapped
+         *  buffers, so insert and erase derive their indices here.
+         */
+        size_type _logical_index(const_pointer _ptr) const noexcept
+        {
+            if (_ptr == end_of_storage)
+                return size();
+            if (_ptr >= start)
+                return std::min<size_type>(_ptr - start, size());
+
+            return std::min<size_type>((end_of_storage - start) + (_ptr - start_of_storage), size());
+        }
+
+        /**
+         * @brief Opens a _n-slot gap at logical index _p by shifting the
+         *  smaller side of the buffer in place; no scratch storage is
+         *  involved. When the gap would exceed capacity the elements at
+         *  the far side are overwritten. Returns the logical index of
+         *  the gap relative to the adjusted start.
+         */
+        size_type _open_gap(size_type _p, size_type _n)
+        {
+            const size_type cap = capacity();
+            const size_type sz = size();
+            const pointer base = start_of_storage;
+            size_type head_idx = start - base;
+            const size_type dropped = sz + _n > cap ? sz + _n - cap : 0;
+            if (_p >= sz - _p) {
+                if constexpr (std::is_trivially_copyable_v<Tp>) {
+                    size_type i = sz;
+                    while (i > _p) {
+                        const size_type src = (head_idx + i - 1) % cap;
+                        const size_type dst = (head_idx + i - 1 + _n) % cap;
+                        const size_type len = std::min(std::min(i - _p, src + 1), dst + 1);
+                        std::memmove(base + dst + 1 - len, base + src + 1 - len, len * sizeof(Tp));
+                        i -= len;
+                    }
+                } else {
+                    for (size_type i = sz; i-- > _p;)
+                        base[(head_idx + i + _n) % cap] = std::move(base[(head_idx + i) % cap]);
+                }
+                count = sz + _n - dropped;
+                if (dropped)
+                    _stat_overwrite(dropped);
+                _stat_occupancy();
+                start = base + (head_idx + dropped) % cap;
+                head_idx = start - base;
+                finish = count == cap ? end_of_storage : base + (head_idx + count) % cap;
+                return _p >= dropped ? _p - dropped : 0;
+            }
+            const size_type new_head = (head_idx + cap - _n % cap) % cap;
+            if constexpr (std::is_trivially_copyable_v<Tp>) {
+                size_type i = 0;
+                while (i < _p) {
+                    const size_type src = (head_idx + i) % cap;
+                    const size_type dst = (new_head + i) % cap;
+                    const size_type len = std::min(std::min(_p - i, cap - src), cap - dst);
+                    std::memmove(base + dst, base + src, len * sizeof(Tp));
+                    i += len;
+                }
+            } else {
+                for (size_type i = 0; i < _p; i++)
+                    base[(new_head + i) % cap] = std::move(base[(head_idx + i) % cap]);
+            }
+            count = sz + _n - dropped;
+            if (dropped)
+                _stat_overwrite(dropped);
+            _stat_occupancy();
+            start = base + new_head;
+            finish = count == cap ? end_of_storage : base + (new_head + count) % cap;
+            return _p;
+        }
+
+        /**
+         * @brief Removes the _k-element window at logical index _p by
+         *  shifting the smaller surviving side of the buffer in place,
+         *  segment-wise. The vacated slots are destroyed the same way
+         *  pop_back and pop_front destroy theirs.
+         */
+        void _close_gap(size_type _p, size_type _k)
+        {
+            const size_type cap = capacity();
+            const size_type sz = size();
+            if (_p >= sz)
+                return;
+            _k = std::min(_k, sz - _p);
+            const pointer base = start_of_storage;
+            const size_type head_idx = start - base;
+            if (finish == end_of_storage)
+                finish = start;
+            if (_p <= sz - _p - _k) {
+                if constexpr (std::is_trivially_copyable_v<Tp>) {
+                    size_type i = _p;
+                    while (i > 0) {
+                        const size_type src = (head_idx + i - 1) % cap;
+                        const size_type dst = (head_idx + i - 1 + _k) % cap;
+                        const size_type len = std::min(std::min(i, src + 1), dst + 1);
+                        std::memmove(base + dst + 1 - len, base + src + 1 - len, len * sizeof(Tp));
+                        i -= len;
+                    }
+                } else {
+                    for (size_type i = _p; i-- > 0;)
+                        base[(head_idx + i + _k) % cap] = std::move(base[(head_idx + i) % cap]);
+                }
+                for (size_type i = 0; i < _k; i++)
+                    std::_Destroy(base + (head_idx + i) % cap);
+                start = base + (head_idx + _k) % cap;
+                count = sz - _k;
+                if (count == 0)
+                    finish = start;
+                return;
+            }
+            if constexpr (std::is_trivially_copyable_v<Tp>) {
+                size_type i = _p + _k;
+                while (i < sz) {
+                    const size_type src = (head_idx + i) % cap;
+                    const size_type dst = (head_idx + i - _k) % cap;
+                    const size_type len = std::min(std::min(sz - i, cap - src), cap - dst);
+                    std::memmove(base + dst, base + src, len * sizeof(Tp));
+                    i += len;
+                }
+            } else {
+                for (size_type i = _p + _k; i < sz; i++)
+                    base[(head_idx + i - _k) % cap] = std::move(base[(head_idx + i) % cap]);
+            }
+            for (size_type i = sz - _k; i < sz; i++)
+                std::_Destroy(base + (head_idx + i) % cap);
+            count = sz - _k;
+            finish = base + (head_idx + count) % cap;
+        }
+
+        /// Runs _fn(first, count) over up to _threads contiguous
+        /// chunks of [_first, _first + _n), each on its own thread;
+        /// falls back to a direct call for a single chunk.
+        template<typename Fn>
+        static void _parallel_chunks(pointer _first, size_type _n, size_type _threads, Fn&& _fn)
+        {
+            const size_type workers = std::min(_threads ? _threads : 1, _n ? _n : 1);
+            if (workers < 2) {
+                _fn(_first, _n);
+                return;
+            }
+            std::vector<std::thread> pool;
+            pool.reserve(workers);
+            const size_type chunk = _n / workers;
+            for (size_type cur = 0; cur < workers; cur++) {
+                pointer chunk_first = _first + cur * chunk;
+                const size_type chunk_count = cur + 1 == workers ? _n - cur * chunk : chunk;
+                pool.emplace_back([&_fn, chunk_first, chunk_count] { _fn(chunk_first, chunk_count); });
+            }
+            for (auto& worker: pool)
+                worker.join();
+        }
+
+        /// Relocates the first _n logical elements into _dst with one
+        /// memcpy per physical segment; only selected for trivially
+        /// relocatable types, whose source slots need no destruction.
+        pointer _relocate_segments(pointer _dst, size_type _n) noexcept
+        {
+            const size_type contiguous = std::min<size_type>(_n, end_of_storage - start);
+            std::memcpy(static_cast<void*>(_dst), static_cast<const void*>(start),
+                        contiguous * sizeof(Tp));
+            std::memcpy(static_cast<void*>(_dst + contiguous), static_cast<const void*>(start_of_storage),
+                        (_n - contiguous) * sizeof(Tp));
+
+            return _dst + _n;
         }
 
         void _reallocate_storage_default(size_type _new_size)
         {
+            _stat_realloc(std::min(size(), _new_size) * sizeof(Tp));
             if (_new_size >= size()) {
-                pointer new_start = alloc.allocate(_new_size);
+                pointer new_start = std::allocator_traits<allocator_type>::allocate(alloc, _new_size);
                 try {
                     std::__uninitialized_default_n_a(new_start + size(), _new_size - size(), alloc);
                 }
                 catch (...) {
-                    alloc.deallocate(new_start, _new_size);
+                    std::allocator_traits<allocator_type>::deallocate(alloc, new_start, _new_size);
                     throw std::length_error("allocator throw");
                 }
-                finish = std::__relocate_a(begin(),
-                                           end(),
-                                           new_start, alloc);
-                alloc.deallocate(start_of_storage, end_of_storage - start_of_storage);
+                if constexpr (is_trivially_relocatable_v<Tp>)
+                    finish = _relocate_segments(new_start, size());
+                else
+                    finish = std::__relocate_a(begin(),
+                                               end(),
+                                               new_start, alloc);
+                std::allocator_traits<allocator_type>::deallocate(alloc, start_of_storage, end_of_storage - start_of_storage);
                 start = start_of_storage = new_start;
                 end_of_storage = new_start + _new_size;
             } else {
-                pointer new_start = alloc.allocate(_new_size);
-                finish = std::__relocate_a(begin(),
-                                           begin() + _new_size,
-                                           new_start, alloc);
-                alloc.deallocate(start_of_storage, end_of_storage - start_of_storage);
+                pointer new_start = std::allocator_traits<allocator_type>::allocate(alloc, _new_size);
+                if constexpr (is_trivially_relocatable_v<Tp>)
+                    finish = _relocate_segments(new_start, _new_size);
+                else
+                    finish = std::__relocate_a(begin(),
+                                               begin() + _new_size,
+                                               new_start, alloc);
+                std::allocator_traits<allocator_type>::deallocate(alloc, start_of_storage, end_of_storage - start_of_storage);
                 start = start_of_storage = new_start;
                 end_of_storage = new_start + _new_size;
+                count = _new_size;
             }
         }
 
         void _reallocate_storage_filled(size_type _new_size, const value_type& _value)
         {
+            _stat_realloc(std::min(size(), _new_size) * sizeof(Tp));
             if (_new_size >= size()) {
-                pointer new_start = alloc.allocate(_new_size);
+                pointer new_start = std::allocator_traits<allocator_type>::allocate(alloc, _new_size);
                 try {
                     std::__uninitialized_fill_n_a(new_start + size(), _new_size - size(), _value, alloc);
                 }
                 catch (...) {
-                    alloc.deallocate(new_start, _new_size);
+                    std::allocator_traits<allocator_type>::deallocate(alloc, new_start, _new_size);
                     throw std::length_error("allocator throw");
                 }
-                std::__relocate_a(begin(),
-                                  end(),
-                                  new_start, alloc);
-                alloc.deallocate(start_of_storage, end_of_storage - start_of_storage);
+                if constexpr (is_trivially_relocatable_v<Tp>)
+                    _relocate_segments(new_start, size());
+                else
+                    std::__relocate_a(begin(),
+                                      end(),
+                                      new_start, alloc);
+                std::allocator_traits<allocator_type>::deallocate(alloc, start_of_storage, end_of_storage - start_of_storage);
                 start = start_of_storage = new_start;
                 finish = end_of_storage = new_start + _new_size;
+                count = _new_size;
             } else {
-                pointer new_start = alloc.allocate(_new_size);
-                finish = std::__relocate_a(begin(),
-                                           begin() + _new_size,
-                                           new_start, alloc);
-                alloc.deallocate(start_of_storage, end_of_storage - start_of_storage);
+                pointer new_start = std::allocator_traits<allocator_type>::allocate(alloc, _new_size);
+                if constexpr (is_trivially_relocatable_v<Tp>)
+                    finish = _relocate_segments(new_start, _new_size);
+                else
+                    finish = std::__relocate_a(begin(),
+                                               begin() + _new_size,
+                                               new_start, alloc);
+                std::allocator_traits<allocator_type>::deallocate(alloc, start_of_storage, end_of_storage - start_of_storage);
                 start = start_of_storage = new_start;
                 end_of_storage = new_start + _new_size;
+                count = _new_size;
             }
         }
     };
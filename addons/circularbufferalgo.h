@@ -0,0 +1,111 @@
+#ifndef CIRCULAR_BUFFER_CIRCULARBUFFERALGO_H
+#define CIRCULAR_BUFFER_CIRCULARBUFFERALGO_H
+
+#include <utility>
+
+
+namespace addons {
+    /**
+     * @brief Segment-aware counterparts of the common <algorithm> and
+     *  <numeric> kernels. Iterating through CBuffIterator keeps the
+     *  wrap branch inside the loop body, which blocks vectorization;
+     *  these functions split the buffer into its at-most-two contiguous
+     *  runs via segments()/for_each_segment and scan each run with a
+     *  tight pointer loop the compiler can auto-vectorize.
+     *
+     * They work with any of the buffer classes exposing the segment
+     * view (CircularBuffer, CircularBufferExt).
+     *
+     * @ingroup algorithms
+     */
+
+    /// Iterator to the first element equal to _value, or end().
+    template<typename Buffer, typename Tp>
+    auto find(Buffer& _buffer, const Tp& _value)
+    {
+        typename Buffer::size_type offset = 0;
+        for (const auto& seg: _buffer.segments()) {
+            for (auto cur = seg.first; cur != seg.first + seg.second; ++cur)
+                if (*cur == _value)
+                    return _buffer.begin() + (offset + (cur - seg.first));
+            offset += seg.second;
+        }
+        return _buffer.end();
+    }
+
+    /// Iterator to the smallest element, or end() when empty.
+    template<typename Buffer>
+    auto min_element(Buffer& _buffer)
+    {
+        if (_buffer.empty())
+            return _buffer.end();
+        typename Buffer::size_type best = 0;
+        typename Buffer::size_type offset = 0;
+        auto best_value = _buffer.front();
+        for (const auto& seg: _buffer.segments()) {
+            for (auto cur = seg.first; cur != seg.first + seg.second; ++cur)
+                if (*cur < best_value) {
+                    best_value = *cur;
+                    best = offset + (cur - seg.first);
+                }
+            offset += seg.second;
+        }
+        return _buffer.begin() + best;
+    }
+
+    /// Iterator to the largest element, or end() when empty.
+    template<typename Buffer>
+    auto max_element(Buffer& _buffer)
+    {
+        if (_buffer.empty())
+            return _buffer.end();
+        typename Buffer::size_type best = 0;
+        typename Buffer::size_type offset = 0;
+        auto best_value = _buffer.front();
+        for (const auto& seg: _buffer.segments()) {
+            for (auto cur = seg.first; cur != seg.first + seg.second; ++cur)
+                if (best_value < *cur) {
+                    best_value = *cur;
+                    best = offset + (cur - seg.first);
+                }
+            offset += seg.second;
+        }
+        return _buffer.begin() + best;
+    }
+
+    /// Left fold of all elements onto _init with operator+.
+    template<typename Buffer, typename Tp>
+    Tp accumulate(const Buffer& _buffer, Tp _init)
+    {
+        _buffer.for_each_segment([&_init](const auto* _first, const auto* _last) {
+            for (; _first != _last; ++_first)
+                _init = std::move(_init) + *_first;
+        });
+        return _init;
+    }
+
+    /// Left fold of all elements onto _init with _op.
+    template<typename Buffer, typename Tp, typename BinaryOp>
+    Tp reduce(const Buffer& _buffer, Tp _init, BinaryOp _op)
+    {
+        _buffer.for_each_segment([&_init, &_op](const auto* _first, const auto* _last) {
+            for (; _first != _last; ++_first)
+                _init = _op(std::move(_init), *_first);
+        });
+        return _init;
+    }
+
+    /// Number of elements equal to _value.
+    template<typename Buffer, typename Tp>
+    typename Buffer::size_type count(const Buffer& _buffer, const Tp& _value)
+    {
+        typename Buffer::size_type matched = 0;
+        _buffer.for_each_segment([&matched, &_value](const auto* _first, const auto* _last) {
+            for (; _first != _last; ++_first)
+                matched += *_first == _value;
+        });
+        return matched;
+    }
+}
+
+#endif
@@ -0,0 +1,436 @@
+#ifndef CIRCULAR_BUFFER_CIRCULARBUFFERPOW2_H
+#define CIRCULAR_BUFFER_CIRCULARBUFFERPOW2_H
+
+#include <bit>
+#include <memory>
+
+
+namespace addons {
+    template<typename Tp>
+    class CBuffPow2Iterator;
+
+    /**
+     * @brief A circular buffer whose capacity is always rounded up to a
+     *  power of two, so every index wrap is a single `index & mask`
+     *  instead of the compare-and-branch wrapping CBuffIterator does.
+     *  Head and tail are monotonically increasing counters; iterator
+     *  advance is plain integer arithmetic and branch-free.
+     *
+     *  @ingroup sequences
+     *
+     * @tparam Tp  Type of element
+     */
+    template<typename Tp, typename Alloc = std::allocator<Tp>>
+    class CircularBufferPow2 {
+    public:
+        typedef Tp value_type;
+        typedef Alloc allocator_type;
+        typedef Tp* pointer;
+        typedef const Tp* const_pointer;
+        typedef Tp& reference;
+        typedef const Tp& const_reference;
+        typedef CBuffPow2Iterator<Tp> iterator;
+        typedef const CBuffPow2Iterator<Tp> const_iterator;
+        typedef std::reverse_iterator<iterator> reverse_iterator;
+        typedef std::reverse_iterator<const_iterator> const_reverse_iterator;
+        typedef size_t size_type;
+        typedef ptrdiff_t difference_type;
+
+    private:
+        pointer storage;
+        size_type mask;
+        size_type head;
+        size_type tail;
+        allocator_type alloc;
+
+    public:
+        // Constructors / destructors / copy
+
+        CircularBufferPow2() noexcept
+            : storage(), mask(), head(), tail()
+        {}
+
+        explicit CircularBufferPow2(size_type _n)
+            : head(), tail()
+        {
+            const size_type rounded = std::bit_ceil(_n ? _n : 1);
+            storage = alloc.allocate(rounded);
+            mask = rounded - 1;
+        }
+
+        explicit CircularBufferPow2(size_type _n, const_reference _value)
+            : CircularBufferPow2(_n)
+        {
+            for (; tail != _n; tail++) {
+                std::allocator_traits<allocator_type>::construct(alloc, storage + tail, _value);
+            }
+        }
+
+        CircularBufferPow2(std::initializer_list<value_type> _list)
+            : CircularBufferPow2(_list.size())
+        {
+            for (const auto& value: _list) {
+                std::allocator_traits<allocator_type>::construct(alloc, storage + tail++, value);
+            }
+        }
+
+        CircularBufferPow2(const CircularBufferPow2& _x)
+            : head(), tail(), alloc(_x.alloc)
+        {
+            storage = alloc.allocate(_x.capacity());
+            mask = _x.mask;
+            for (; tail != _x.size(); tail++) {
+                std::allocator_traits<allocator_type>::construct(alloc, storage + tail, _x[tail]);
+            }
+        }
+
+        CircularBufferPow2(CircularBufferPow2&& _x) noexcept
+            : storage(_x.storage), mask(_x.mask), head(_x.head), tail(_x.tail),
+              alloc(std::move(_x.alloc))
+        {
+            _x.storage = pointer();
+            _x.mask = _x.head = _x.tail = 0;
+        }
+
+        CircularBufferPow2& operator=(const CircularBufferPow2& _x)
+        {
+            if (this != &_x) {
+                CircularBufferPow2 copied(_x);
+                swap(copied);
+            }
+
+            return *this;
+        }
+
+        CircularBufferPow2& operator=(CircularBufferPow2&& _x) noexcept
+        {
+            clear();
+            swap(_x);
+
+            return *this;
+        }
+
+        ~CircularBufferPow2() noexcept
+        {
+            this->clear();
+        }
+
+        // Public member functions
+
+        iterator begin() noexcept
+        {
+            return iterator(storage, mask, head);
+        }
+
+        const_iterator begin() const noexcept
+        {
+            return const_iterator(storage, mask, head);
+        }
+
+        iterator end() noexcept
+        {
+            return iterator(storage, mask, tail);
+        }
+
+        const_iterator end() const noexcept
+        {
+            return const_iterator(storage, mask, tail);
+        }
+
+        const_iterator cbegin() const noexcept
+        {
+            return const_iterator(storage, mask, head);
+        }
+
+        const_iterator cend() const noexcept
+        {
+            return const_iterator(storage, mask, tail);
+        }
+
+        reverse_iterator rbegin() noexcept
+        {
+            return reverse_iterator(end());
+        }
+
+        reverse_iterator rend() noexcept
+        {
+            return reverse_iterator(begin());
+        }
+
+        [[nodiscard]] bool empty() const noexcept
+        {
+            return head == tail;
+        }
+
+        [[nodiscard]] bool full() const noexcept
+        {
+            return size() == capacity();
+        }
+
+        [[nodiscard]] size_type size() const noexcept
+        {
+            return tail - head;
+        }
+
+        [[nodiscard]] size_type capacity() const noexcept
+        {
+            return storage ? mask + 1 : 0;
+        }
+
+        reference front() noexcept
+        {
+            return storage[head & mask];
+        }
+
+        const_reference front() const noexcept
+        {
+            return storage[head & mask];
+        }
+
+        reference back() noexcept
+        {
+            return storage[(tail - 1) & mask];
+        }
+
+        const_reference back() const noexcept
+        {
+            return storage[(tail - 1) & mask];
+        }
+
+        reference operator[](size_type _offset) noexcept
+        {
+            return storage[(head + _offset) & mask];
+        }
+
+        const_reference operator[](size_type _offset) const noexcept
+        {
+            return storage[(head + _offset) & mask];
+        }
+
+        void push_back(const value_type& _value)
+        {
+            if (full()) {
+                storage[tail & mask] = _value;
+                tail++;
+                head++;
+            } else {
+                std::allocator_traits<allocator_type>::construct(alloc, storage + (tail & mask), _value);
+                tail++;
+            }
+        }
+
+        void push_back(value_type&& _value)
+        {
+            if (full()) {
+                storage[tail & mask] = std::move(_value);
+                tail++;
+                head++;
+            } else {
+                std::allocator_traits<allocator_type>::construct(alloc, storage + (tail & mask), std::move(_value));
+                tail++;
+            }
+        }
+
+        void push_front(const value_type& _value)
+        {
+            if (full()) {
+                storage[(head - 1) & mask] = _value;
+                head--;
+                tail--;
+            } else {
+                std::allocator_traits<allocator_type>::construct(alloc, storage + ((head - 1) & mask), _value);
+                head--;
+            }
+        }
+
+        void push_front(value_type&& _value)
+        {
+            if (full()) {
+                storage[(head - 1) & mask] = std::move(_value);
+                head--;
+                tail--;
+            } else {
+                std::allocator_traits<allocator_type>::construct(alloc, storage + ((head - 1) & mask), std::move(_value));
+                head--;
+            }
+        }
+
+        void pop_back()
+        {
+            if (!empty()) {
+                tail--;
+                std::allocator_traits<allocator_type>::destroy(alloc, storage + (tail & mask));
+            }
+        }
+
+        void pop_front()
+        {
+            if (!empty()) {
+                std::allocator_traits<allocator_type>::destroy(alloc, storage + (head & mask));
+                head++;
+            }
+        }
+
+        void swap(CircularBufferPow2& _x) noexcept
+        {
+            std::swap(storage, _x.storage);
+            std::swap(mask, _x.mask);
+            std::swap(head, _x.head);
+            std::swap(tail, _x.tail);
+            std::swap(alloc, _x.alloc);
+        }
+
+        void clear() noexcept
+        {
+            for (; head != tail; head++) {
+                std::allocator_traits<allocator_type>::destroy(alloc, storage + (head & mask));
+            }
+            if (storage)
+                alloc.deallocate(storage, mask + 1);
+            storage = pointer();
+            mask = head = tail = 0;
+        }
+    };
+
+    /**
+     * @brief Iterator over CircularBufferPow2. Stores a monotonically
+     *  increasing index and wraps with a mask only on dereference, so
+     *  advance, comparison and difference compile to plain integer ops.
+     *
+     * @ingroup iterators
+     *
+     * @tparam Tp  Type of element
+     */
+    template<typename Tp>
+    class CBuffPow2Iterator {
+    public:
+        typedef Tp* pointer;
+        [[maybe_unused]] typedef std::random_access_iterator_tag iterator_category;
+        typedef Tp value_type;
+        typedef Tp& reference;
+        typedef ptrdiff_t difference_type;
+        typedef size_t size_type;
+
+    private:
+        pointer storage;
+        size_type mask;
+        size_type index;
+
+    public:
+        CBuffPow2Iterator() noexcept
+            : storage(), mask(), index()
+        {}
+
+        explicit CBuffPow2Iterator(pointer _storage, size_type _mask, size_type _index) noexcept
+            : storage(_storage), mask(_mask), index(_index)
+        {}
+
+        reference operator*() const noexcept
+        {
+            return storage[index & mask];
+        }
+
+        pointer operator->() const noexcept
+        {
+            return storage + (index & mask);
+        }
+
+        reference operator[](difference_type _offset) const noexcept
+        {
+            return storage[(index + _offset) & mask];
+        }
+
+        CBuffPow2Iterator& operator++() noexcept
+        {
+            index++;
+            return *this;
+        }
+
+        CBuffPow2Iterator operator++(int) noexcept
+        {
+            auto old = *this;
+            index++;
+            return old;
+        }
+
+        CBuffPow2Iterator& operator--() noexcept
+        {
+            index--;
+            return *this;
+        }
+
+        CBuffPow2Iterator operator--(int) noexcept
+        {
+            auto old = *this;
+            index--;
+            return old;
+        }
+
+        CBuffPow2Iterator& operator+=(difference_type _offset) noexcept
+        {
+            index += _offset;
+            return *this;
+        }
+
+        CBuffPow2Iterator& operator-=(difference_type _offset) noexcept
+        {
+            index -= _offset;
+            return *this;
+        }
+
+        friend CBuffPow2Iterator operator+(CBuffPow2Iterator _it, difference_type _offset) noexcept
+        {
+            _it += _offset;
+            return _it;
+        }
+
+        friend CBuffPow2Iterator operator+(difference_type _offset, CBuffPow2Iterator _it) noexcept
+        {
+            _it += _offset;
+            return _it;
+        }
+
+        friend CBuffPow2Iterator operator-(CBuffPow2Iterator _it, difference_type _offset) noexcept
+        {
+            _it -= _offset;
+            return _it;
+        }
+
+        friend difference_type operator-(const CBuffPow2Iterator& _left, const CBuffPow2Iterator& _right) noexcept
+        {
+            return static_cast<difference_type>(_left.index - _right.index);
+        }
+
+        friend bool operator==(const CBuffPow2Iterator& _left, const CBuffPow2Iterator& _right) noexcept
+        {
+            return _left.index == _right.index;
+        }
+
+        friend bool operator!=(const CBuffPow2Iterator& _left, const CBuffPow2Iterator& _right) noexcept
+        {
+            return _left.index != _right.index;
+        }
+
+        friend bool operator<(const CBuffPow2Iterator& _left, const CBuffPow2Iterator& _right) noexcept
+        {
+            return static_cast<difference_type>(_left.index - _right.index) < 0;
+        }
+
+        friend bool operator>(const CBuffPow2Iterator& _left, const CBuffPow2Iterator& _right) noexcept
+        {
+            return _right < _left;
+        }
+
+        friend bool operator<=(const CBuffPow2Iterator& _left, const CBuffPow2Iterator& _right) noexcept
+        {
+            return !(_right < _left);
+        }
+
+        friend bool operator>=(const CBuffPow2Iterator& _left, const CBuffPow2Iterator& _right) noexcept
+        {
+            return !(_left < _right);
+        }
+    };
+}
+
+#endif
@@ -0,0 +1,340 @@
+#ifndef CIRCULAR_BUFFER_CIRCULARBUFFERSTATIC_H
+#define CIRCULAR_BUFFER_CIRCULARBUFFERSTATIC_H
+
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <utility>
+
+
+namespace addons {
+    template<typename Tp, size_t N>
+    class CBuffStaticIterator;
+
+    /**
+     * @brief A fixed-capacity circular buffer with inline storage, so no
+     *  allocation happens at all and the whole buffer can live inside a
+     *  cache-hot struct. Head/count indices replace the four-pointer
+     *  representation, and every operation is constexpr, usable in
+     *  constant evaluation.
+     *
+     *  Requires a default-constructible element type; all N slots are
+     *  kept constructed, push overwrites the oldest element when full.
+     *
+     *  @ingroup sequences
+     *
+     * @tparam Tp  Type of element
+     * @tparam N   Capacity, fixed at compile time
+     */
+    template<typename Tp, size_t N>
+    class CircularBufferStatic {
+        static_assert(N > 0, "static buffer needs a nonzero capacity");
+
+    public:
+        typedef Tp value_type;
+        typedef Tp* pointer;
+        typedef const Tp* const_pointer;
+        typedef Tp& reference;
+        typedef const Tp& const_reference;
+        typedef CBuffStaticIterator<Tp, N> iterator;
+        typedef const CBuffStaticIterator<Tp, N> const_iterator;
+        typedef std::reverse_iterator<iterator> reverse_iterator;
+        typedef size_t size_type;
+        typedef ptrdiff_t difference_type;
+
+    private:
+        Tp elems[N];
+        size_type head;
+        size_type count;
+
+    public:
+        // Constructors
+
+        constexpr CircularBufferStatic() noexcept
+            : elems(), head(), count()
+        {}
+
+        constexpr CircularBufferStatic(std::initializer_list<value_type> _list)
+            : elems(), head(), count()
+        {
+            for (const auto& value: _list) {
+                push_back(value);
+            }
+        }
+
+        // Public member functions
+
+        constexpr iterator begin() noexcept
+        {
+            return iterator(elems, head);
+        }
+
+        constexpr const_iterator begin() const noexcept
+        {
+            return const_iterator(elems, head);
+        }
+
+        constexpr iterator end() noexcept
+        {
+            return iterator(elems, head + count);
+        }
+
+        constexpr const_iterator end() const noexcept
+        {
+            return const_iterator(elems, head + count);
+        }
+
+        [[nodiscard]] constexpr bool empty() const noexcept
+        {
+            return count == 0;
+        }
+
+        [[nodiscard]] constexpr bool full() const noexcept
+        {
+            return count == N;
+        }
+
+        [[nodiscard]] constexpr size_type size() const noexcept
+        {
+            return count;
+        }
+
+        [[nodiscard]] constexpr size_type capacity() const noexcept
+        {
+            return N;
+        }
+
+        [[nodiscard]] constexpr size_type max_size() const noexcept
+        {
+            return N;
+        }
+
+        constexpr reference front() noexcept
+        {
+            return elems[head];
+        }
+
+        constexpr const_reference front() const noexcept
+        {
+            return elems[head];
+        }
+
+        constexpr reference back() noexcept
+        {
+            return elems[(head + count - 1) % N];
+        }
+
+        constexpr const_reference back() const noexcept
+        {
+            return elems[(head + count - 1) % N];
+        }
+
+        constexpr reference operator[](size_type _offset) noexcept
+        {
+            return elems[(head + _offset) % N];
+        }
+
+        constexpr const_reference operator[](size_type _offset) const noexcept
+        {
+            return elems[(head + _offset) % N];
+        }
+
+        constexpr void push_back(const value_type& _value)
+        {
+            elems[(head + count) % N] = _value;
+            if (count == N)
+                head = (head + 1) % N;
+            else
+                count++;
+        }
+
+        constexpr void push_back(value_type&& _value)
+        {
+            elems[(head + count) % N] = std::move(_value);
+            if (count == N)
+                head = (head + 1) % N;
+            else
+                count++;
+        }
+
+        constexpr void push_front(const value_type& _value)
+        {
+            head = (head + N - 1) % N;
+            elems[head] = _value;
+            if (count < N)
+                count++;
+        }
+
+        constexpr void push_front(value_type&& _value)
+        {
+            head = (head + N - 1) % N;
+            elems[head] = std::move(_value);
+            if (count < N)
+                count++;
+        }
+
+        constexpr void pop_back() noexcept
+        {
+            if (count)
+                count--;
+        }
+
+        constexpr void pop_front() noexcept
+        {
+            if (count) {
+                head = (head + 1) % N;
+                count--;
+            }
+        }
+
+        constexpr void clear() noexcept
+        {
+            head = count = 0;
+        }
+    };
+
+    /**
+     * @brief Iterator over CircularBufferStatic. Monotonic index wrapped
+     *  by modulo only on dereference; all operations are constexpr.
+     *
+     * @ingroup iterators
+     *
+     * @tparam Tp  Type of element
+     * @tparam N   Capacity of the underlying buffer
+     */
+    template<typename Tp, size_t N>
+    class CBuffStaticIterator {
+    public:
+        typedef Tp* pointer;
+        [[maybe_unused]] typedef std::random_access_iterator_tag iterator_category;
+        typedef Tp value_type;
+        typedef Tp& reference;
+        typedef ptrdiff_t difference_type;
+        typedef size_t size_type;
+
+    private:
+        pointer storage;
+        size_type index;
+
+    public:
+        constexpr CBuffStaticIterator() noexcept
+            : storage(), index()
+        {}
+
+        constexpr explicit CBuffStaticIterator(pointer _storage, size_type _index) noexcept
+            : storage(_storage), index(_index)
+        {}
+
+        constexpr explicit CBuffStaticIterator(const Tp* _storage, size_type _index) noexcept
+            : storage(const_cast<pointer>(_storage)), index(_index)
+        {}
+
+        constexpr reference operator*() const noexcept
+        {
+            return storage[index % N];
+        }
+
+        constexpr pointer operator->() const noexcept
+        {
+            return storage + index % N;
+        }
+
+        constexpr reference operator[](difference_type _offset) const noexcept
+        {
+            return storage[(index + _offset) % N];
+        }
+
+        constexpr CBuffStaticIterator& operator++() noexcept
+        {
+            index++;
+            return *this;
+        }
+
+        constexpr CBuffStaticIterator operator++(int) noexcept
+        {
+            auto old = *this;
+            index++;
+            return old;
+        }
+
+        constexpr CBuffStaticIterator& operator--() noexcept
+        {
+            index--;
+            return *this;
+        }
+
+        constexpr CBuffStaticIterator operator--(int) noexcept
+        {
+            auto old = *this;
+            index--;
+            return old;
+        }
+
+        constexpr CBuffStaticIterator& operator+=(difference_type _offset) noexcept
+        {
+            index += _offset;
+            return *this;
+        }
+
+        constexpr CBuffStaticIterator& operator-=(difference_type _offset) noexcept
+        {
+            index -= _offset;
+            return *this;
+        }
+
+        friend constexpr CBuffStaticIterator operator+(CBuffStaticIterator _it, difference_type _offset) noexcept
+        {
+            _it += _offset;
+            return _it;
+        }
+
+        friend constexpr CBuffStaticIterator operator+(difference_type _offset, CBuffStaticIterator _it) noexcept
+        {
+            _it += _offset;
+            return _it;
+        }
+
+        friend constexpr CBuffStaticIterator operator-(CBuffStaticIterator _it, difference_type _offset) noexcept
+        {
+            _it -= _offset;
+            return _it;
+        }
+
+        friend constexpr difference_type operator-(const CBuffStaticIterator& _left, const CBuffStaticIterator& _right) noexcept
+        {
+            return static_cast<difference_type>(_left.index - _right.index);
+        }
+
+        friend constexpr bool operator==(const CBuffStaticIterator& _left, const CBuffStaticIterator& _right) noexcept
+        {
+            return _left.index == _right.index;
+        }
+
+        friend constexpr bool operator!=(const CBuffStaticIterator& _left, const CBuffStaticIterator& _right) noexcept
+        {
+            return _left.index != _right.index;
+        }
+
+        friend constexpr bool operator<(const CBuffStaticIterator& _left, const CBuffStaticIterator& _right) noexcept
+        {
+            return static_cast<difference_type>(_left.index - _right.index) < 0;
+        }
+
+        friend constexpr bool operator>(const CBuffStaticIterator& _left, const CBuffStaticIterator& _right) noexcept
+        {
+            return _right < _left;
+        }
+
+        friend constexpr bool operator<=(const CBuffStaticIterator& _left, const CBuffStaticIterator& _right) noexcept
+        {
+            return !(_right < _left);
+        }
+
+        friend constexpr bool operator>=(const CBuffStaticIterator& _left, const CBuffStaticIterator& _right) noexcept
+        {
+            return !(_left < _right);
+        }
+    };
+}
+
+#endif
@@ -0,0 +1,167 @@
+#ifndef CIRCULAR_BUFFER_CIRCULARBYTEBUFFER_H
+#define CIRCULAR_BUFFER_CIRCULARBYTEBUFFER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <span>
+
+
+namespace addons {
+    /**
+     * @brief A byte ring for variable-length records. Each record is
+     *  stored inline as a 32-bit length prefix followed by its payload,
+     *  so pushing a packet is at most four memcpy calls into the ring
+     *  and reading one chases no pointers at all — the per-message
+     *  allocation of CircularBuffer<std::string> disappears.
+     *
+     *  Records wrap freely over the physical end of storage; consume()
+     *  hands the payload to the callback as the at-most-two contiguous
+     *  spans it occupies, zero-copy.
+     *
+     *  @ingroup sequences
+     *
+     * @tparam Alloc  Allocator used for the byte storage
+     */
+    template<typename Alloc = std::allocator<std::byte>>
+    class CircularByteBuffer {
+    public:
+        typedef std::byte value_type;
+        typedef Alloc allocator_type;
+        typedef std::byte* pointer;
+        typedef size_t size_type;
+        typedef uint32_t length_type;
+
+    private:
+        pointer storage;
+        size_type cap;
+        size_type head;
+        size_type used;
+        size_type records;
+        allocator_type alloc;
+
+        /// Copies _n bytes into the ring starting at logical offset
+        /// _offset from head, in at most two runs.
+        void _write(size_type _offset, const std::byte* _src, size_type _n) noexcept
+        {
+            const size_type write_idx = (head + _offset) % cap;
+            const size_type contiguous = std::min(_n, cap - write_idx);
+            std::memcpy(storage + write_idx, _src, contiguous);
+            std::memcpy(storage, _src + contiguous, _n - contiguous);
+        }
+
+        /// Copies _n bytes out of the ring starting at the head.
+        void _read(std::byte* _dst, size_type _n) const noexcept
+        {
+            const size_type contiguous = std::min(_n, cap - head);
+            std::memcpy(_dst, storage + head, contiguous);
+            std::memcpy(_dst + contiguous, storage, _n - contiguous);
+        }
+
+    public:
+        // Constructors / destructors
+
+        explicit CircularByteBuffer(size_type _capacity_bytes)
+            : cap(_capacity_bytes), head(), used(), records()
+        {
+            storage = std::allocator_traits<allocator_type>::allocate(alloc, cap);
+        }
+
+        CircularByteBuffer(const CircularByteBuffer&) = delete;
+        CircularByteBuffer& operator=(const CircularByteBuffer&) = delete;
+
+        ~CircularByteBuffer() noexcept
+        {
+            std::allocator_traits<allocator_type>::deallocate(alloc, storage, cap);
+        }
+
+        // Public member functions
+
+        [[nodiscard]] size_type capacity() const noexcept
+        {
+            return cap;
+        }
+
+        /// Bytes currently occupied, length prefixes included.
+        [[nodiscard]] size_type size_bytes() const noexcept
+        {
+            return used;
+        }
+
+        /// Number of whole records currently stored.
+        [[nodiscard]] size_type size() const noexcept
+        {
+            return records;
+        }
+
+        [[nodiscard]] bool empty() const noexcept
+        {
+            return records == 0;
+        }
+
+        /**
+         * @brief Appends one record; returns false when the prefix plus
+         *  payload does not fit in the free space. The record lands
+         *  inline in the ring, wrapping over the physical end when
+         *  needed.
+         */
+        bool push(std::span<const std::byte> _record)
+        {
+            const length_type length = _record.size();
+            if (sizeof(length_type) + _record.size() > cap - used)
+                return false;
+            _write(used, reinterpret_cast<const std::byte*>(&length), sizeof(length_type));
+            _write(used + sizeof(length_type), _record.data(), _record.size());
+            used += sizeof(length_type) + _record.size();
+            records++;
+
+            return true;
+        }
+
+        /**
+         * @brief Pops the oldest record and invokes
+         *  _fn(first, second) with the at-most-two contiguous spans of
+         *  its payload, second empty unless the record wraps. The spans
+         *  point into the ring and are only valid during the call.
+         *  Returns whether a record was consumed.
+         */
+        template<typename Fn>
+        bool consume(Fn&& _fn)
+        {
+            if (!records)
+                return false;
+            length_type length;
+            _read(reinterpret_cast<std::byte*>(&length), sizeof(length_type));
+            const size_type payload_idx = (head + sizeof(length_type)) % cap;
+            const size_type contiguous = std::min<size_type>(length, cap - payload_idx);
+            _fn(std::span<const std::byte>(storage + payload_idx, contiguous),
+                std::span<const std::byte>(storage, length - contiguous));
+            head = (payload_idx + length) % cap;
+            used -= sizeof(length_type) + length;
+            records--;
+
+            return true;
+        }
+
+        /// Drains every record through consume(); returns the number drained.
+        template<typename Fn>
+        size_type consume_all(Fn&& _fn)
+        {
+            size_type drained = 0;
+            while (consume(_fn))
+                drained++;
+
+            return drained;
+        }
+
+        void clear() noexcept
+        {
+            head = 0;
+            used = 0;
+            records = 0;
+        }
+    };
+}
+
+#endif
@@ -0,0 +1,209 @@
+#ifndef CIRCULAR_BUFFER_COWCIRCULARBUFFER_H
+#define CIRCULAR_BUFFER_COWCIRCULARBUFFER_H
+
+#include <memory>
+#include <mutex>
+
+#include "circularbuffer.h"
+
+
+namespace addons {
+    /**
+     * @brief A copy-on-write wrapper around CircularBuffer for the
+     *  one-writer many-readers telemetry pattern. snapshot() returns an
+     *  immutable ref-counted view in O(1); the writer pays the deep
+     *  copy only on its first mutation while snapshots are still
+     *  alive, instead of stalling for a full copy on every snapshot.
+     *
+     *  Copy-on-write happens at whole-buffer granularity: the first
+     *  write after a snapshot clones the buffer once, later writes are
+     *  free again until the next snapshot.
+     *
+     *  snapshot() may be called from any thread concurrently with the
+     *  writer: the pointer handoff is guarded by a short critical
+     *  section, and a reader then works on its immutable snapshot with
+     *  no further synchronization. Mutations themselves must still come
+     *  from one writer at a time.
+     *
+     *  @ingroup sequences
+     *
+     * @tparam Tp  Type of element
+     */
+    template<typename Tp, typename Alloc = std::allocator<Tp>>
+    class CowCircularBuffer {
+    public:
+        typedef CircularBuffer<Tp, Alloc> buffer_type;
+        typedef Tp value_type;
+        typedef typename buffer_type::size_type size_type;
+        typedef typename buffer_type::const_reference const_reference;
+
+        /**
+         * @brief An immutable view over the buffer state at the moment
+         *  snapshot() was called. Keeps the storage alive and unchanged
+         *  for as long as the snapshot exists.
+         */
+        class Snapshot {
+            std::shared_ptr<const buffer_type> storage;
+
+        public:
+            explicit Snapshot(std::shared_ptr<const buffer_type> _storage) noexcept
+                : storage(std::move(_storage))
+            {}
+
+            [[nodiscard]] bool empty() const noexcept
+            {
+                return storage->empty();
+            }
+
+            [[nodiscard]] size_type size() const noexcept
+            {
+                return storage->size();
+            }
+
+            const_reference operator[](size_type _offset) const
+            {
+                return (*storage)[_offset];
+            }
+
+            const_reference front() const
+            {
+                return storage->front();
+            }
+
+            const_reference back() const
+            {
+                return (*storage)[storage->size() - 1];
+            }
+
+            auto begin() const noexcept
+            {
+                return storage->begin();
+            }
+
+            auto end() const noexcept
+            {
+                return storage->end();
+            }
+        };
+
+    private:
+        std::shared_ptr<buffer_type> storage;
+        mutable std::mutex lock;
+
+        /// Clones the storage if any snapshot still references it.
+        /// Must be called with the lock held, so no snapshot can be
+        /// taken between the check and the in-place mutation.
+        void _detach()
+        {
+            if (storage.use_count() > 1)
+                storage = std::make_shared<buffer_type>(*storage);
+        }
+
+    public:
+        // Constructors
+
+        CowCircularBuffer()
+            : storage(std::make_shared<buffer_type>())
+        {}
+
+        explicit CowCircularBuffer(size_type _n, const_reference _value)
+            : storage(std::make_shared<buffer_type>(_n, _value))
+        {}
+
+        CowCircularBuffer(std::initializer_list<value_type> _list)
+            : storage(std::make_shared<buffer_type>(_list))
+        {}
+
+        // Public member functions
+
+        /// O(1) immutable view of the current contents; safe to call
+        /// concurrently with the writer.
+        [[nodiscard]] Snapshot snapshot() const
+        {
+            std::lock_guard<std::mutex> guard(lock);
+
+            return Snapshot(storage);
+        }
+
+        [[nodiscard]] bool empty() const noexcept
+        {
+            return storage->empty();
+        }
+
+        [[nodiscard]] size_type size() const noexcept
+        {
+            return storage->size();
+        }
+
+        [[nodiscard]] size_type capacity() const noexcept
+        {
+            return storage->capacity();
+        }
+
+        const_reference operator[](size_type _offset) const
+        {
+            return (*storage)[_offset];
+        }
+
+        const_reference front() const
+        {
+            return storage->front();
+        }
+
+        const_reference back() const
+        {
+            return (*storage)[storage->size() - 1];
+        }
+
+        void push_back(const value_type& _value)
+        {
+            std::lock_guard<std::mutex> guard(lock);
+            _detach();
+            storage->push_back(_value);
+        }
+
+        void push_back(value_type&& _value)
+        {
+            std::lock_guard<std::mutex> guard(lock);
+            _detach();
+            storage->push_back(std::move(_value));
+        }
+
+        void push_front(const value_type& _value)
+        {
+            std::lock_guard<std::mutex> guard(lock);
+            _detach();
+            storage->push_front(_value);
+        }
+
+        void push_front(value_type&& _value)
+        {
+            std::lock_guard<std::mutex> guard(lock);
+            _detach();
+            storage->push_front(std::move(_value));
+        }
+
+        void pop_back()
+        {
+            std::lock_guard<std::mutex> guard(lock);
+            _detach();
+            storage->pop_back();
+        }
+
+        void pop_front()
+        {
+            std::lock_guard<std::mutex> guard(lock);
+            _detach();
+            storage->pop_front();
+        }
+
+        void clear()
+        {
+            std::lock_guard<std::mutex> guard(lock);
+            _detach();
+            storage->clear();
+        }
+    };
+}
+
+#endif
@@ -0,0 +1,217 @@
+#ifndef CIRCULAR_BUFFER_MAPPEDCIRCULARBUFFER_H
+#define CIRCULAR_BUFFER_MAPPEDCIRCULARBUFFER_H
+
+#ifdef __unix__
+
+#include <cstddef>
+#include <cstdint>
+#include <fcntl.h>
+#include <stdexcept>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <type_traits>
+#include <unistd.h>
+
+
+namespace addons {
+    /**
+     * @brief A fixed-capacity circular buffer whose element array lives
+     *  in a memory-mapped file, so the contents survive a process
+     *  restart. A small header at the front of the file persists the
+     *  head/count offsets; reopening the same file is an mmap plus two
+     *  offset reads instead of replaying the source stream, and the OS
+     *  page cache handles write-back.
+     *
+     *  Requires a trivially copyable element type; push overwrites the
+     *  oldest element when full.
+     *
+     *  @ingroup sequences
+     *
+     * @tparam Tp  Type of element
+     */
+    template<typename Tp>
+    class MappedCircularBuffer {
+        static_assert(std::is_trivially_copyable_v<Tp>,
+                      "MappedCircularBuffer requires a trivially copyable element type");
+
+    public:
+        typedef Tp value_type;
+        typedef Tp* pointer;
+        typedef const Tp* const_pointer;
+        typedef Tp& reference;
+        typedef const Tp& const_reference;
+        typedef size_t size_type;
+        typedef ptrdiff_t difference_type;
+
+    private:
+        struct FileHeader {
+            uint64_t magic;
+            uint64_t element_size;
+            uint64_t capacity;
+            uint64_t head;
+            uint64_t count;
+        };
+
+        static constexpr uint64_t MAGIC = 0x0050414D46465542ull; // "BUFFMAP\0"
+
+        int fd;
+        void* map;
+        size_type mapped_bytes;
+        FileHeader* header;
+        pointer storage;
+
+    public:
+        // Constructors / destructors
+
+        /**
+         * @brief Opens or creates the backing file at _path sized for
+         *  _capacity elements. A fresh file starts empty; an existing
+         *  one must carry a matching header and brings its contents
+         *  back as-is.
+         */
+        MappedCircularBuffer(const char* _path, size_type _capacity)
+            : fd(-1), map(), mapped_bytes(), header(), storage()
+        {
+            fd = ::open(_path, O_RDWR | O_CREAT, 0644);
+            if (fd < 0)
+                throw std::runtime_error("cannot open backing file");
+            struct stat st{};
+            if (::fstat(fd, &st) != 0) {
+                ::close(fd);
+                throw std::runtime_error("cannot stat backing file");
+            }
+            const bool fresh = st.st_size == 0;
+            mapped_bytes = sizeof(FileHeader) + _capacity * sizeof(Tp);
+            if (fresh && ::ftruncate(fd, mapped_bytes) != 0) {
+                ::close(fd);
+                throw std::runtime_error("cannot size backing file");
+            }
+            map = ::mmap(nullptr, mapped_bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+            if (map == MAP_FAILED) {
+                ::close(fd);
+                throw std::runtime_error("cannot map backing file");
+            }
+            header = static_cast<FileHeader*>(map);
+            storage = reinterpret_cast<pointer>(static_cast<char*>(map) + sizeof(FileHeader));
+            if (fresh) {
+                *header = {MAGIC, sizeof(Tp), _capacity, 0, 0};
+            } else if (header->magic != MAGIC
+                       || header->element_size != sizeof(Tp)
+                       || header->capacity != _capacity) {
+                ::munmap(map, mapped_bytes);
+                ::close(fd);
+                throw std::runtime_error("backing file does not match this buffer type");
+            }
+        }
+
+        MappedCircularBuffer(const MappedCircularBuffer&) = delete;
+
+        MappedCircularBuffer& operator=(const MappedCircularBuffer&) = delete;
+
+        MappedCircularBuffer(MappedCircularBuffer&& _x) noexcept
+            : fd(_x.fd), map(_x.map), mapped_bytes(_x.mapped_bytes),
+              header(_x.header), storage(_x.storage)
+        {
+            _x.fd = -1;
+            _x.map = nullptr;
+            _x.header = nullptr;
+            _x.storage = nullptr;
+        }
+
+        ~MappedCircularBuffer()
+        {
+            if (map) {
+                ::msync(map, mapped_bytes, MS_ASYNC);
+                ::munmap(map, mapped_bytes);
+            }
+            if (fd >= 0)
+                ::close(fd);
+        }
+
+        // Public member functions
+
+        [[nodiscard]] bool empty() const noexcept
+        {
+            return header->count == 0;
+        }
+
+        [[nodiscard]] bool full() const noexcept
+        {
+            return header->count == header->capacity;
+        }
+
+        [[nodiscard]] size_type size() const noexcept
+        {
+            return header->count;
+        }
+
+        [[nodiscard]] size_type capacity() const noexcept
+        {
+            return header->capacity;
+        }
+
+        reference front() noexcept
+        {
+            return storage[header->head];
+        }
+
+        const_reference front() const noexcept
+        {
+            return storage[header->head];
+        }
+
+        reference back() noexcept
+        {
+            return storage[(header->head + header->count - 1) % header->capacity];
+        }
+
+        const_reference back() const noexcept
+        {
+            return storage[(header->head + header->count - 1) % header->capacity];
+        }
+
+        reference operator[](size_type _offset) noexcept
+        {
+            return storage[(header->head + _offset) % header->capacity];
+        }
+
+        const_reference operator[](size_type _offset) const noexcept
+        {
+            return storage[(header->head + _offset) % header->capacity];
+        }
+
+        void push_back(const value_type& _value)
+        {
+            storage[(header->head + header->count) % header->capacity] = _value;
+            if (header->count == header->capacity)
+                header->head = (header->head + 1) % header->capacity;
+            else
+                header->count++;
+        }
+
+        void pop_front() noexcept
+        {
+            if (header->count) {
+                header->head = (header->head + 1) % header->capacity;
+                header->count--;
+            }
+        }
+
+        void clear() noexcept
+        {
+            header->head = 0;
+            header->count = 0;
+        }
+
+        /// Forces the mapped pages out to the backing file synchronously.
+        void flush()
+        {
+            if (::msync(map, mapped_bytes, MS_SYNC) != 0)
+                throw std::runtime_error("cannot flush backing file");
+        }
+    };
+}
+
+#endif
+
+#endif
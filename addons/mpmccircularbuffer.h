@@ -0,0 +1,157 @@
+#ifndef CIRCULAR_BUFFER_MPMCCIRCULARBUFFER_H
+#define CIRCULAR_BUFFER_MPMCCIRCULARBUFFER_H
+
+#include <atomic>
+#include <bit>
+#include <memory>
+#include <optional>
+
+
+namespace addons {
+    /**
+     * @brief A bounded multi-producer/multi-consumer circular buffer.
+     *  Every slot carries its own sequence number (Vyukov scheme): a
+     *  producer claims a slot with one compare-exchange on the tail and
+     *  publishes it by bumping the slot sequence, a consumer does the
+     *  mirror image on the head, so threads never block and contend only
+     *  on the counter they actually advance.
+     *
+     *  @ingroup sequences
+     *
+     * @tparam Tp  Type of element
+     */
+    template<typename Tp, typename Alloc = std::allocator<Tp>>
+    class MPMCCircularBuffer {
+    public:
+        typedef Tp value_type;
+        typedef Tp* pointer;
+        typedef size_t size_type;
+
+        static constexpr size_type cache_line_size = 64;
+
+    private:
+        struct Slot {
+            std::atomic<size_type> sequence;
+            alignas(Tp) unsigned char payload[sizeof(Tp)];
+
+            pointer get_ptr() noexcept
+            {
+                return std::launder(reinterpret_cast<pointer>(payload));
+            }
+        };
+
+        typedef typename std::allocator_traits<Alloc>::template rebind_alloc<Slot> slot_allocator_type;
+
+        Slot* slots;
+        size_type mask;
+        slot_allocator_type alloc;
+
+        alignas(cache_line_size) std::atomic<size_type> head;
+        alignas(cache_line_size) std::atomic<size_type> tail;
+
+    public:
+        typedef Alloc allocator_type;
+
+        // Constructors / destructors
+
+        explicit MPMCCircularBuffer(size_type _n)
+            : mask(std::bit_ceil(_n ? _n : 1) - 1), head(), tail()
+        {
+            slots = alloc.allocate(mask + 1);
+            for (size_type cur = 0; cur <= mask; cur++) {
+                slots[cur].sequence.store(cur, std::memory_order_relaxed);
+            }
+        }
+
+        MPMCCircularBuffer(const MPMCCircularBuffer&) = delete;
+        MPMCCircularBuffer& operator=(const MPMCCircularBuffer&) = delete;
+
+        ~MPMCCircularBuffer() noexcept
+        {
+            while (try_pop_front()) {}
+            alloc.deallocate(slots, mask + 1);
+        }
+
+        // Public member functions
+
+        [[nodiscard]] size_type capacity() const noexcept
+        {
+            return mask + 1;
+        }
+
+        /// Approximate when called concurrently.
+        [[nodiscard]] size_type size() const noexcept
+        {
+            const size_type t = tail.load(std::memory_order_acquire);
+            const size_type h = head.load(std::memory_order_acquire);
+            return t - h;
+        }
+
+        [[nodiscard]] bool empty() const noexcept
+        {
+            return size() == 0;
+        }
+
+        /// Returns false if the buffer is full. Never blocks.
+        bool try_push_back(const value_type& _value)
+        {
+            return try_emplace_back(_value);
+        }
+
+        bool try_push_back(value_type&& _value)
+        {
+            return try_emplace_back(std::move(_value));
+        }
+
+        template<typename... Args>
+        bool try_emplace_back(Args&&... _args)
+        {
+            size_type pos = tail.load(std::memory_order_relaxed);
+            Slot* cell;
+            for (;;) {
+                cell = &slots[pos & mask];
+                const size_type seq = cell->sequence.load(std::memory_order_acquire);
+                const auto dif = static_cast<ptrdiff_t>(seq - pos);
+                if (dif == 0) {
+                    if (tail.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                        break;
+                } else if (dif < 0) {
+                    return false;
+                } else {
+                    pos = tail.load(std::memory_order_relaxed);
+                }
+            }
+            ::new (static_cast<void*>(cell->payload)) value_type(std::forward<Args>(_args)...);
+            cell->sequence.store(pos + 1, std::memory_order_release);
+
+            return true;
+        }
+
+        /// Returns std::nullopt if the buffer is empty. Never blocks.
+        std::optional<value_type> try_pop_front()
+        {
+            size_type pos = head.load(std::memory_order_relaxed);
+            Slot* cell;
+            for (;;) {
+                cell = &slots[pos & mask];
+                const size_type seq = cell->sequence.load(std::memory_order_acquire);
+                const auto dif = static_cast<ptrdiff_t>(seq - (pos + 1));
+                if (dif == 0) {
+                    if (head.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                        break;
+                } else if (dif < 0) {
+                    return std::nullopt;
+                } else {
+                    pos = head.load(std::memory_order_relaxed);
+                }
+            }
+            std::optional<value_type> popped(std::move(*cell->get_ptr()));
+            cell->get_ptr()->~value_type();
+            cell->sequence.store(pos + mask + 1, std::memory_order_release);
+
+            return popped;
+        }
+    };
+}
+
+#endif
@@ -0,0 +1,93 @@
+#ifndef CIRCULAR_BUFFER_POOLALLOCATOR_H
+#define CIRCULAR_BUFFER_POOLALLOCATOR_H
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <unordered_map>
+#include <vector>
+
+
+namespace addons {
+    /**
+     * @brief An allocator recycling blocks through per-size free lists
+     *  instead of returning them to the global heap. Tuned for the
+     *  buffer's allocate-once pattern: many short-lived buffers of
+     *  similar capacity keep reusing the same few blocks. Copies and
+     *  rebound instances share one pool, and the pool itself is freed
+     *  once the last of them goes away.
+     *
+     *  @ingroup allocators
+     *
+     * @tparam Tp  Type of element
+     */
+    template<typename Tp>
+    class PoolAllocator {
+        template<typename Up>
+        friend class PoolAllocator;
+
+        struct Pool {
+            std::unordered_map<size_t, std::vector<void*>> free_blocks;
+
+            ~Pool()
+            {
+                for (auto& [bytes, blocks]: free_blocks)
+                    for (void* block: blocks)
+                        ::operator delete(block, std::align_val_t(alignof(std::max_align_t)));
+            }
+        };
+
+        std::shared_ptr<Pool> pool;
+
+    public:
+        typedef Tp value_type;
+        typedef size_t size_type;
+        typedef ptrdiff_t difference_type;
+        typedef std::true_type propagate_on_container_copy_assignment;
+        typedef std::true_type propagate_on_container_move_assignment;
+        typedef std::true_type propagate_on_container_swap;
+
+        template<typename Up>
+        struct rebind {
+            typedef PoolAllocator<Up> other;
+        };
+
+        PoolAllocator()
+            : pool(std::make_shared<Pool>())
+        {}
+
+        template<typename Up>
+        PoolAllocator(const PoolAllocator<Up>& _x) noexcept
+            : pool(_x.pool)
+        {}
+
+        Tp* allocate(size_type _n)
+        {
+            auto& bucket = pool->free_blocks[_n * sizeof(Tp)];
+            if (!bucket.empty()) {
+                void* block = bucket.back();
+                bucket.pop_back();
+                return static_cast<Tp*>(block);
+            }
+            return static_cast<Tp*>(::operator new(_n * sizeof(Tp),
+                                                   std::align_val_t(alignof(std::max_align_t))));
+        }
+
+        void deallocate(Tp* _ptr, size_type _n)
+        {
+            pool->free_blocks[_n * sizeof(Tp)].push_back(_ptr);
+        }
+
+        friend bool operator==(const PoolAllocator& _left, const PoolAllocator& _right) noexcept
+        {
+            return _left.pool == _right.pool;
+        }
+
+        friend bool operator!=(const PoolAllocator& _left, const PoolAllocator& _right) noexcept
+        {
+            return _left.pool != _right.pool;
+        }
+    };
+}
+
+#endif
@@ -0,0 +1,163 @@
+#ifndef CIRCULAR_BUFFER_SHARDEDCIRCULARBUFFER_H
+#define CIRCULAR_BUFFER_SHARDEDCIRCULARBUFFER_H
+
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <vector>
+
+#include "spsccircularbuffer.h"
+
+
+namespace addons {
+    /**
+     * @brief A sharded aggregate of cache-line-isolated SPSC rings, one
+     *  per producer thread. Each producer registers once and then
+     *  pushes into its own shard with no contention at all, so a push
+     *  costs the same as a single-threaded one; the consumer drains all
+     *  shards through one callback, optionally k-way-merged by a user
+     *  key extractor.
+     *
+     *  One thread per shard on the producer side and one draining
+     *  thread are the caller's responsibility, as with
+     *  SPSCCircularBuffer itself.
+     *
+     *  @ingroup sequences
+     *
+     * @tparam Tp  Type of element
+     */
+    template<typename Tp, typename Alloc = std::allocator<Tp>>
+    class ShardedCircularBuffer {
+    public:
+        typedef Tp value_type;
+        typedef Alloc allocator_type;
+        typedef size_t size_type;
+
+        static constexpr size_type cache_line_size = SPSCCircularBuffer<Tp, Alloc>::cache_line_size;
+
+    private:
+        /// Padded so neighbouring shards never share a cache line.
+        struct alignas(cache_line_size) Shard {
+            SPSCCircularBuffer<Tp, Alloc> ring;
+
+            explicit Shard(size_type _n)
+                : ring(_n)
+            {}
+        };
+
+        std::vector<std::unique_ptr<Shard>> shards;
+        std::atomic<size_type> registered;
+
+    public:
+        // Constructors
+
+        ShardedCircularBuffer(size_type _shards, size_type _capacity_per_shard)
+            : registered()
+        {
+            shards.reserve(_shards);
+            for (size_type cur = 0; cur < _shards; cur++)
+                shards.push_back(std::make_unique<Shard>(_capacity_per_shard));
+        }
+
+        ShardedCircularBuffer(const ShardedCircularBuffer&) = delete;
+        ShardedCircularBuffer& operator=(const ShardedCircularBuffer&) = delete;
+
+        // Public member functions
+
+        [[nodiscard]] size_type shard_count() const noexcept
+        {
+            return shards.size();
+        }
+
+        /// Elements across all shards; approximate while producers run.
+        [[nodiscard]] size_type size() const noexcept
+        {
+            size_type total = 0;
+            for (const auto& shard: shards)
+                total += shard->ring.size();
+
+            return total;
+        }
+
+        [[nodiscard]] bool empty() const noexcept
+        {
+            return size() == 0;
+        }
+
+        /**
+         * @brief Claims the next free shard for the calling producer
+         *  thread. Each producer calls this once and pushes with the
+         *  returned index; throws std::length_error once every shard
+         *  is taken.
+         */
+        size_type register_producer()
+        {
+            const size_type shard = registered.fetch_add(1, std::memory_order_relaxed);
+            if (shard >= shards.size())
+                throw std::length_error("more producers than shards");
+
+            return shard;
+        }
+
+        /// Contention-free push into the calling producer's own shard.
+        bool try_push_back(size_type _shard, const value_type& _value)
+        {
+            return shards[_shard]->ring.try_push_back(_value);
+        }
+
+        bool try_push_back(size_type _shard, value_type&& _value)
+        {
+            return shards[_shard]->ring.try_push_back(std::move(_value));
+        }
+
+        /**
+         * @brief Consumer side: drains whatever every shard holds at
+         *  call time through _fn, shard by shard. Returns the number
+         *  of elements drained.
+         */
+        template<typename Fn>
+        size_type drain(Fn&& _fn)
+        {
+            size_type drained = 0;
+            for (auto& shard: shards) {
+                while (auto popped = shard->ring.try_pop_front()) {
+                    _fn(std::move(*popped));
+                    drained++;
+                }
+            }
+
+            return drained;
+        }
+
+        /**
+         * @brief Consumer side: drains all shards k-way-merged by
+         *  _key, so elements come out in ascending key order (e.g. a
+         *  timestamp extractor) provided each producer pushed in key
+         *  order. Returns the number of elements drained.
+         */
+        template<typename Fn, typename KeyFn>
+        size_type drain_merged(Fn&& _fn, KeyFn&& _key)
+        {
+            std::vector<std::optional<value_type>> fronts(shards.size());
+            for (size_type cur = 0; cur < shards.size(); cur++)
+                fronts[cur] = shards[cur]->ring.try_pop_front();
+
+            size_type drained = 0;
+            while (true) {
+                size_type next = shards.size();
+                for (size_type cur = 0; cur < shards.size(); cur++)
+                    if (fronts[cur] && (next == shards.size() || _key(*fronts[cur]) < _key(*fronts[next])))
+                        next = cur;
+                if (next == shards.size())
+                    break;
+                _fn(std::move(*fronts[next]));
+                drained++;
+                fronts[next] = shards[next]->ring.try_pop_front();
+            }
+
+            return drained;
+        }
+    };
+}
+
+#endif
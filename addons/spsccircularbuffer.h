@@ -0,0 +1,134 @@
+#ifndef CIRCULAR_BUFFER_SPSCCIRCULARBUFFER_H
+#define CIRCULAR_BUFFER_SPSCCIRCULARBUFFER_H
+
+#include <atomic>
+#include <bit>
+#include <memory>
+#include <optional>
+
+
+namespace addons {
+    /**
+     * @brief A wait-free single-producer/single-consumer circular buffer.
+     *  Head and tail are monotonically increasing atomic counters over a
+     *  power-of-two storage, published with acquire/release ordering, so
+     *  one producer thread and one consumer thread need no lock at all.
+     *
+     *  Producer and consumer state live on separate cache lines, and each
+     *  side keeps a cached copy of the counterpart's counter so the other
+     *  side's cache line is only touched when the buffer looks full/empty.
+     *
+     *  @ingroup sequences
+     *
+     * @tparam Tp  Type of element
+     */
+    template<typename Tp, typename Alloc = std::allocator<Tp>>
+    class SPSCCircularBuffer {
+    public:
+        typedef Tp value_type;
+        typedef Alloc allocator_type;
+        typedef Tp* pointer;
+        typedef Tp& reference;
+        typedef const Tp& const_reference;
+        typedef size_t size_type;
+
+        static constexpr size_type cache_line_size = 64;
+
+    private:
+        pointer storage;
+        size_type mask;
+        allocator_type alloc;
+
+        // Consumer side
+        alignas(cache_line_size) std::atomic<size_type> head;
+        size_type cached_tail;
+
+        // Producer side
+        alignas(cache_line_size) std::atomic<size_type> tail;
+        size_type cached_head;
+
+    public:
+        // Constructors / destructors
+
+        explicit SPSCCircularBuffer(size_type _n)
+            : mask(std::bit_ceil(_n ? _n : 1) - 1), head(), cached_tail(), tail(), cached_head()
+        {
+            storage = alloc.allocate(mask + 1);
+        }
+
+        SPSCCircularBuffer(const SPSCCircularBuffer&) = delete;
+        SPSCCircularBuffer& operator=(const SPSCCircularBuffer&) = delete;
+
+        ~SPSCCircularBuffer() noexcept
+        {
+            for (size_type cur = head.load(std::memory_order_relaxed);
+                 cur != tail.load(std::memory_order_relaxed); cur++) {
+                std::allocator_traits<allocator_type>::destroy(alloc, storage + (cur & mask));
+            }
+            alloc.deallocate(storage, mask + 1);
+        }
+
+        // Public member functions
+
+        [[nodiscard]] size_type capacity() const noexcept
+        {
+            return mask + 1;
+        }
+
+        /// Approximate when called concurrently; exact when either side is quiescent.
+        [[nodiscard]] size_type size() const noexcept
+        {
+            return tail.load(std::memory_order_acquire) - head.load(std::memory_order_acquire);
+        }
+
+        [[nodiscard]] bool empty() const noexcept
+        {
+            return size() == 0;
+        }
+
+        /// Producer side. Returns false if the buffer is full.
+        bool try_push_back(const value_type& _value)
+        {
+            return try_emplace_back(_value);
+        }
+
+        bool try_push_back(value_type&& _value)
+        {
+            return try_emplace_back(std::move(_value));
+        }
+
+        template<typename... Args>
+        bool try_emplace_back(Args&&... _args)
+        {
+            const size_type cur = tail.load(std::memory_order_relaxed);
+            if (cur - cached_head > mask) {
+                cached_head = head.load(std::memory_order_acquire);
+                if (cur - cached_head > mask)
+                    return false;
+            }
+            std::allocator_traits<allocator_type>::construct(alloc, storage + (cur & mask),
+                                                             std::forward<Args>(_args)...);
+            tail.store(cur + 1, std::memory_order_release);
+
+            return true;
+        }
+
+        /// Consumer side. Returns std::nullopt if the buffer is empty.
+        std::optional<value_type> try_pop_front()
+        {
+            const size_type cur = head.load(std::memory_order_relaxed);
+            if (cur == cached_tail) {
+                cached_tail = tail.load(std::memory_order_acquire);
+                if (cur == cached_tail)
+                    return std::nullopt;
+            }
+            std::optional<value_type> popped(std::move(storage[cur & mask]));
+            std::allocator_traits<allocator_type>::destroy(alloc, storage + (cur & mask));
+            head.store(cur + 1, std::memory_order_release);
+
+            return popped;
+        }
+    };
+}
+
+#endif
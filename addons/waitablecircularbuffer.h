@@ -0,0 +1,212 @@
+#ifndef CIRCULAR_BUFFER_WAITABLECIRCULARBUFFER_H
+#define CIRCULAR_BUFFER_WAITABLECIRCULARBUFFER_H
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <optional>
+
+#include "spsccircularbuffer.h"
+
+
+namespace addons {
+    /**
+     * @brief A blocking single-producer/single-consumer buffer composed
+     *  over SPSCCircularBuffer. Under load every operation stays on the
+     *  wait-free fast path; only after a bounded spin does a side park
+     *  on a condition variable, so an idle queue burns no core and a
+     *  busy one never touches the mutex.
+     *
+     *  The mutex and condition variables are only ever taken by a side
+     *  that has already failed its spin, and the opposite side only
+     *  locks when the parked flag says someone is actually waiting.
+     *
+     *  @ingroup sequences
+     *
+     * @tparam Tp  Type of element
+     */
+    template<typename Tp, typename Alloc = std::allocator<Tp>>
+    class WaitableCircularBuffer {
+    public:
+        typedef Tp value_type;
+        typedef Alloc allocator_type;
+        typedef size_t size_type;
+
+        static constexpr int spin_rounds = 1024;
+
+    private:
+        SPSCCircularBuffer<Tp, Alloc> ring;
+
+        std::mutex lock;
+        std::condition_variable not_empty;
+        std::condition_variable not_full;
+        std::atomic<bool> consumer_parked;
+        std::atomic<bool> producer_parked;
+
+        /// Full barrier between the ring update just made and the
+        /// parked-flag read, pairing with the fence in the wait paths;
+        /// without it both sides can read stale values and the wakeup
+        /// is lost.
+        void _wake_consumer()
+        {
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (consumer_parked.load(std::memory_order_relaxed)) {
+                std::lock_guard<std::mutex> guard(lock);
+                not_empty.notify_one();
+            }
+        }
+
+        void _wake_producer()
+        {
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (producer_parked.load(std::memory_order_relaxed)) {
+                std::lock_guard<std::mutex> guard(lock);
+                not_full.notify_one();
+            }
+        }
+
+    public:
+        // Constructors
+
+        explicit WaitableCircularBuffer(size_type _n)
+            : ring(_n), consumer_parked(), producer_parked()
+        {}
+
+        WaitableCircularBuffer(const WaitableCircularBuffer&) = delete;
+        WaitableCircularBuffer& operator=(const WaitableCircularBuffer&) = delete;
+
+        // Public member functions
+
+        [[nodiscard]] size_type capacity() const noexcept
+        {
+            return ring.capacity();
+        }
+
+        [[nodiscard]] size_type size() const noexcept
+        {
+            return ring.size();
+        }
+
+        [[nodiscard]] bool empty() const noexcept
+        {
+            return ring.empty();
+        }
+
+        /// Producer side, non-blocking. Returns false if full.
+        bool try_push_back(const value_type& _value)
+        {
+            if (ring.try_push_back(_value)) {
+                _wake_consumer();
+                return true;
+            }
+            return false;
+        }
+
+        /// Producer side; spins, then parks until there is room.
+        void push_back_wait(const value_type& _value)
+        {
+            for (int spin = 0; spin < spin_rounds; spin++) {
+                if (try_push_back(_value))
+                    return;
+            }
+            std::unique_lock<std::mutex> guard(lock);
+            producer_parked.store(true, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            while (!ring.try_push_back(_value))
+                not_full.wait(guard);
+            producer_parked.store(false, std::memory_order_relaxed);
+            guard.unlock();
+            _wake_consumer();
+        }
+
+        /**
+         * @brief Producer side; spins, then parks until there is room
+         *  or _timeout elapses. Returns whether the element was stored.
+         */
+        template<typename Rep, typename Period>
+        bool push_back_wait(const value_type& _value,
+                            const std::chrono::duration<Rep, Period>& _timeout)
+        {
+            for (int spin = 0; spin < spin_rounds; spin++) {
+                if (try_push_back(_value))
+                    return true;
+            }
+            const auto deadline = std::chrono::steady_clock::now() + _timeout;
+            std::unique_lock<std::mutex> guard(lock);
+            producer_parked.store(true, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            bool stored = false;
+            while (!(stored = ring.try_push_back(_value))) {
+                if (not_full.wait_until(guard, deadline) == std::cv_status::timeout) {
+                    stored = ring.try_push_back(_value);
+                    break;
+                }
+            }
+            producer_parked.store(false, std::memory_order_relaxed);
+            guard.unlock();
+            if (stored)
+                _wake_consumer();
+            return stored;
+        }
+
+        /// Consumer side, non-blocking. Returns nullopt if empty.
+        std::optional<value_type> try_pop_front()
+        {
+            auto popped = ring.try_pop_front();
+            if (popped)
+                _wake_producer();
+            return popped;
+        }
+
+        /// Consumer side; spins, then parks until an element arrives.
+        value_type pop_front_wait()
+        {
+            for (int spin = 0; spin < spin_rounds; spin++) {
+                if (auto popped = try_pop_front())
+                    return std::move(*popped);
+            }
+            std::unique_lock<std::mutex> guard(lock);
+            consumer_parked.store(true, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            std::optional<value_type> popped;
+            while (!(popped = ring.try_pop_front()))
+                not_empty.wait(guard);
+            consumer_parked.store(false, std::memory_order_relaxed);
+            guard.unlock();
+            _wake_producer();
+            return std::move(*popped);
+        }
+
+        /**
+         * @brief Consumer side; spins, then parks until an element
+         *  arrives or _timeout elapses. Returns nullopt on timeout.
+         */
+        template<typename Rep, typename Period>
+        std::optional<value_type> pop_front_wait(const std::chrono::duration<Rep, Period>& _timeout)
+        {
+            for (int spin = 0; spin < spin_rounds; spin++) {
+                if (auto popped = try_pop_front())
+                    return popped;
+            }
+            const auto deadline = std::chrono::steady_clock::now() + _timeout;
+            std::unique_lock<std::mutex> guard(lock);
+            consumer_parked.store(true, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            std::optional<value_type> popped;
+            while (!(popped = ring.try_pop_front())) {
+                if (not_empty.wait_until(guard, deadline) == std::cv_status::timeout) {
+                    popped = ring.try_pop_front();
+                    break;
+                }
+            }
+            consumer_parked.store(false, std::memory_order_relaxed);
+            guard.unlock();
+            if (popped)
+                _wake_producer();
+            return popped;
+        }
+    };
+}
+
+#endif
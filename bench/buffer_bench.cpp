@@ -0,0 +1,171 @@
+#include "addons/circularbuffer.h"
+#include "addons/circularbufferpow2.h"
+
+#include <benchmark/benchmark.h>
+#include <deque>
+#include <numeric>
+
+// Regression benchmarks for the buffer classes. Every hot operation the
+// library exposes is measured against a std::deque baseline, parameterized
+// over buffer capacity (benchmark argument) and element size (template
+// parameter).
+
+namespace {
+
+template<size_t Bytes>
+struct Payload {
+    char data[Bytes];
+};
+
+template<typename T>
+addons::CircularBuffer<T> make_full_buffer(size_t capacity) {
+    addons::CircularBuffer<T> buf(capacity, T());
+    return buf;
+}
+
+template<typename T>
+void BM_CircularBufferPushBack(benchmark::State& state) {
+    auto buf = make_full_buffer<T>(state.range(0));
+    T value{};
+    for (auto _: state) {
+        buf.push_back(value);
+        benchmark::DoNotOptimize(buf);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+template<typename T>
+void BM_CircularBufferPushFront(benchmark::State& state) {
+    auto buf = make_full_buffer<T>(state.range(0));
+    T value{};
+    for (auto _: state) {
+        buf.push_front(value);
+        benchmark::DoNotOptimize(buf);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+template<typename T>
+void BM_CircularBufferPopFront(benchmark::State& state) {
+    const size_t capacity = state.range(0);
+    auto buf = make_full_buffer<T>(capacity);
+    T value{};
+    for (auto _: state) {
+        if (buf.empty()) {
+            state.PauseTiming();
+            for (size_t i = 0; i < capacity; i++) {
+                buf.push_back(value);
+            }
+            state.ResumeTiming();
+        }
+        buf.pop_front();
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+template<typename T>
+void BM_CircularBufferTraversal(benchmark::State& state) {
+    auto buf = make_full_buffer<T>(state.range(0));
+    // Wrap so the traversal crosses the physical storage end
+    buf.push_back(T());
+    buf.push_back(T());
+    for (auto _: state) {
+        for (auto it = buf.begin(); it < buf.end(); ++it) {
+            benchmark::DoNotOptimize(*it);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template<typename T>
+void BM_CircularBufferIndexing(benchmark::State& state) {
+    auto buf = make_full_buffer<T>(state.range(0));
+    buf.push_back(T());
+    for (auto _: state) {
+        for (size_t i = 0; i < buf.size(); i++) {
+            benchmark::DoNotOptimize(buf[i]);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template<typename T>
+void BM_Pow2BufferTraversal(benchmark::State& state) {
+    addons::CircularBufferPow2<T> buf(state.range(0), T());
+    buf.push_back(T());
+    buf.push_back(T());
+    for (auto _: state) {
+        for (auto it = buf.begin(); it < buf.end(); ++it) {
+            benchmark::DoNotOptimize(*it);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * buf.size());
+}
+
+void BM_CircularBufferInsert(benchmark::State& state) {
+    // state.range(1): 0 - head, 1 - middle, 2 - tail
+    auto buf = make_full_buffer<int>(state.range(0));
+    const size_t offset = state.range(1) == 0 ? 1 :
+                          state.range(1) == 1 ? buf.size() / 2 :
+                          buf.size() - 1;
+    for (auto _: state) {
+        buf.insert(buf.begin() + offset, 42);
+        benchmark::DoNotOptimize(buf);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+void BM_CircularBufferExtGrowth(benchmark::State& state) {
+    const size_t target = state.range(0);
+    for (auto _: state) {
+        addons::CircularBufferExt<int> buf;
+        for (size_t i = 0; i < target; i++) {
+            buf.push_back(static_cast<int>(i));
+        }
+        benchmark::DoNotOptimize(buf);
+    }
+    state.SetItemsProcessed(state.iterations() * target);
+}
+
+template<typename T>
+void BM_DequePushBack(benchmark::State& state) {
+    const size_t capacity = state.range(0);
+    std::deque<T> buf(capacity);
+    T value{};
+    for (auto _: state) {
+        buf.pop_front();
+        buf.push_back(value);
+        benchmark::DoNotOptimize(buf);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+template<typename T>
+void BM_DequeTraversal(benchmark::State& state) {
+    std::deque<T> buf(state.range(0));
+    for (auto _: state) {
+        for (auto it = buf.begin(); it != buf.end(); ++it) {
+            benchmark::DoNotOptimize(*it);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+#define BUFFER_BENCH_CAPACITIES RangeMultiplier(64)->Range(64, 1 << 18)
+
+BENCHMARK(BM_CircularBufferPushBack<int>)->BUFFER_BENCH_CAPACITIES;
+BENCHMARK(BM_CircularBufferPushBack<Payload<64>>)->BUFFER_BENCH_CAPACITIES;
+BENCHMARK(BM_CircularBufferPushBack<Payload<512>>)->BUFFER_BENCH_CAPACITIES;
+BENCHMARK(BM_CircularBufferPushFront<int>)->BUFFER_BENCH_CAPACITIES;
+BENCHMARK(BM_CircularBufferPopFront<int>)->BUFFER_BENCH_CAPACITIES;
+BENCHMARK(BM_CircularBufferTraversal<int>)->BUFFER_BENCH_CAPACITIES;
+BENCHMARK(BM_CircularBufferTraversal<Payload<64>>)->BUFFER_BENCH_CAPACITIES;
+BENCHMARK(BM_CircularBufferIndexing<int>)->BUFFER_BENCH_CAPACITIES;
+BENCHMARK(BM_Pow2BufferTraversal<int>)->BUFFER_BENCH_CAPACITIES;
+BENCHMARK(BM_CircularBufferInsert)->ArgsProduct({{1024, 65536}, {0, 1, 2}});
+BENCHMARK(BM_CircularBufferExtGrowth)->RangeMultiplier(8)->Range(1024, 1 << 20);
+BENCHMARK(BM_DequePushBack<int>)->BUFFER_BENCH_CAPACITIES;
+BENCHMARK(BM_DequePushBack<Payload<512>>)->BUFFER_BENCH_CAPACITIES;
+BENCHMARK(BM_DequeTraversal<int>)->BUFFER_BENCH_CAPACITIES;
+
+}
@@ -1,9 +1,69 @@
 #include "addons/circularbuffer.cpp"
+#include "addons/channelcircularbuffer.h"
+#include "addons/circularbufferalgo.h"
+#include "addons/circularbytebuffer.h"
+#include "addons/circularbufferpow2.h"
+#include "addons/spsccircularbuffer.h"
+#include "addons/waitablecircularbuffer.h"
+#include "addons/mpmccircularbuffer.h"
+#include "addons/circularbufferstatic.h"
+#include "addons/cowcircularbuffer.h"
+#include "addons/hugepageallocator.h"
+#include "addons/mappedcircularbuffer.h"
+#include "addons/poolallocator.h"
+#include "addons/shardedcircularbuffer.h"
 #include <gtest/gtest.h>
+
+#include <atomic>
+#include <numeric>
+#include <sstream>
+#include <thread>
 #include <vector>
 
 using namespace addons;
 
+/// Stateful allocator whose instances compare unequal and which never
+/// propagates on assignment, for the allocator-aware move tests.
+template<typename T>
+struct ArenaAllocator {
+    typedef T value_type;
+    typedef std::false_type propagate_on_container_move_assignment;
+    typedef std::false_type propagate_on_container_copy_assignment;
+    typedef std::false_type is_always_equal;
+
+    int arena_id;
+
+    ArenaAllocator() noexcept
+        : arena_id(next_id()++)
+    {}
+
+    template<typename U>
+    ArenaAllocator(const ArenaAllocator<U>& _other) noexcept
+        : arena_id(_other.arena_id)
+    {}
+
+    T* allocate(size_t _n) {
+        return std::allocator<T>().allocate(_n);
+    }
+
+    void deallocate(T* _ptr, size_t _n) noexcept {
+        std::allocator<T>().deallocate(_ptr, _n);
+    }
+
+    friend bool operator==(const ArenaAllocator& _left, const ArenaAllocator& _right) noexcept {
+        return _left.arena_id == _right.arena_id;
+    }
+
+    friend bool operator!=(const ArenaAllocator& _left, const ArenaAllocator& _right) noexcept {
+        return !(_left == _right);
+    }
+
+    static int& next_id() {
+        static int id = 0;
+        return id;
+    }
+};
+
 TEST(CircularBufferTestSuit, ConstructorsTest) {
     addons::CircularBuffer<std::string> a(4, "abc");
     addons::CircularBuffer<int> b = {3, 2, 1, 4, 5};
@@ -311,6 +371,1082 @@ TEST(CircularBufferTestSuit, InsertTest) {
     }
 }
 
+TEST(CircularBufferTestSuit, MoveSemanticsTest) {
+    addons::CircularBuffer<std::string> a = {"12", "ABc", "aBCCD", "Leeks"};
+    const std::string* a_storage = &a.front();
+
+    addons::CircularBuffer<std::string> moved(std::move(a));
+    ASSERT_EQ(moved.size(), 4);
+    ASSERT_EQ(&moved.front(), a_storage);
+    ASSERT_EQ(a.size(), 0);
+    ASSERT_EQ(a.capacity(), 0);
+
+    addons::CircularBuffer<std::string> assigned = {"x1", "x2"};
+    assigned = std::move(moved);
+    ASSERT_EQ(assigned.size(), 4);
+    ASSERT_EQ(&assigned.front(), a_storage);
+    ASSERT_EQ(moved.capacity(), 0);
+
+    addons::CircularBufferExt<std::string> b = {"one", "two", "three"};
+    const std::string* b_storage = &b.front();
+    addons::CircularBufferExt<std::string> b_moved(std::move(b));
+    ASSERT_EQ(b_moved.size(), 3);
+    ASSERT_EQ(&b_moved.front(), b_storage);
+    ASSERT_EQ(b.capacity(), 0);
+
+    std::string payload = "a long enough string to live on the heap for sure";
+    const char* payload_data = payload.data();
+    b_moved.push_back(std::move(payload));
+    ASSERT_EQ(b_moved.back().data(), payload_data);
+
+    // A non-propagating allocator with unequal state forbids adopting
+    // the source storage; the elements must be moved across instead
+    addons::CircularBuffer<std::string, ArenaAllocator<std::string>> c = {"left", "right"};
+    addons::CircularBuffer<std::string, ArenaAllocator<std::string>> c_assigned;
+    const std::string* c_storage = &c.front();
+
+    c_assigned = std::move(c);
+    ASSERT_EQ(c_assigned.size(), 2);
+    ASSERT_NE(&c_assigned.front(), c_storage);
+    ASSERT_EQ(c_assigned.front(), "left");
+    ASSERT_EQ(c_assigned.back(), "right");
+    ASSERT_TRUE(c.empty());
+}
+
+TEST(CircularBufferTestSuit, EmplaceTest) {
+    addons::CircularBuffer<std::string> a = {"12", "ABc", "aBCCD"};
+    a.reserve(5);
+
+    a.emplace_back(3, 'z');
+    ASSERT_EQ(a.back(), "zzz");
+    a.emplace_front(2, 'y');
+    ASSERT_EQ(a.front(), "yy");
+    ASSERT_EQ(a.size(), 5);
+
+    std::string init_a[] = {"yy", "12", "ABc", "aBCCD", "zzz"};
+    int n = 0;
+    for (auto i = a.begin(); i < a.end(); ++i, ++n) {
+        ASSERT_EQ(*i, init_a[n]);
+    }
+
+    addons::CircularBufferExt<std::pair<int, std::string>> b;
+    b.reserve(2);
+    b.emplace_back(1, "first");
+    b.emplace_back(2, "second");
+    ASSERT_EQ(b.size(), 2);
+    ASSERT_EQ(b.front().first, 1);
+    ASSERT_EQ(b.back().second, "second");
+}
+
+TEST(CircularBufferTestSuit, GrowthPolicyTest) {
+    addons::CircularBufferExt<int> a;
+    a.reserve(4);
+
+    for (auto i = 0; i < 4; i++) {
+        a.push_back(i);
+    }
+    ASSERT_EQ(a.capacity(), 4);
+
+    a.push_back(4);
+    ASSERT_EQ(a.size(), 5);
+    ASSERT_EQ(a.capacity(), 8);
+
+    for (auto i = 5; i < 9; i++) {
+        a.push_back(i);
+    }
+    ASSERT_EQ(a.size(), 9);
+    ASSERT_EQ(a.capacity(), 16);
+
+    for (auto i = 0; i < 9; i++) {
+        ASSERT_EQ(a[i], i);
+    }
+
+    addons::CircularBufferExt<int, std::allocator<int>, 4> b;
+    b.reserve(2);
+    b.push_back(1);
+    b.push_back(2);
+    b.push_back(3);
+    ASSERT_EQ(b.capacity(), 8);
+
+    addons::CircularBufferExt<std::string> c;
+    c.push_back("grown from nothing");
+    ASSERT_EQ(c.size(), 1);
+    ASSERT_EQ(c.front(), "grown from nothing");
+}
+
+TEST(CircularBufferTestSuit, Pow2BufferTest) {
+    addons::CircularBufferPow2<int> a(5);
+    ASSERT_EQ(a.capacity(), 8);
+    ASSERT_EQ(a.size(), 0);
+
+    for (auto i = 0; i < 8; i++) {
+        a.push_back(i);
+    }
+    ASSERT_TRUE(a.full());
+
+    a.push_back(8);
+    a.push_back(9);
+    ASSERT_EQ(a.size(), 8);
+    ASSERT_EQ(a.front(), 2);
+    ASSERT_EQ(a.back(), 9);
+
+    int expected = 2;
+    for (auto i = a.begin(); i < a.end(); i++, expected++) {
+        ASSERT_EQ(*i, expected);
+    }
+
+    a.pop_front();
+    ASSERT_EQ(a.front(), 3);
+    a.push_front(-1);
+    ASSERT_EQ(a.front(), -1);
+
+    addons::CircularBufferPow2<std::string> b = {"one", "two", "three"};
+    ASSERT_EQ(b.capacity(), 4);
+    ASSERT_EQ(b[1], "two");
+
+    std::sort(a.begin(), a.end());
+    for (auto i = a.begin(); i + 1 < a.end(); i++) {
+        ASSERT_LE(*i, *(i + 1));
+    }
+
+    auto moved = std::move(b);
+    ASSERT_EQ(moved.size(), 3);
+    ASSERT_EQ(b.capacity(), 0);
+}
+
+TEST(CircularBufferTestSuit, SpscBufferTest) {
+    addons::SPSCCircularBuffer<int> a(4);
+    ASSERT_EQ(a.capacity(), 4);
+
+    ASSERT_TRUE(a.try_push_back(1));
+    ASSERT_TRUE(a.try_push_back(2));
+    ASSERT_TRUE(a.try_push_back(3));
+    ASSERT_TRUE(a.try_push_back(4));
+    ASSERT_FALSE(a.try_push_back(5));
+
+    ASSERT_EQ(a.try_pop_front(), 1);
+    ASSERT_TRUE(a.try_push_back(5));
+    ASSERT_EQ(a.try_pop_front(), 2);
+    ASSERT_EQ(a.try_pop_front(), 3);
+    ASSERT_EQ(a.try_pop_front(), 4);
+    ASSERT_EQ(a.try_pop_front(), 5);
+    ASSERT_EQ(a.try_pop_front(), std::nullopt);
+
+    constexpr int kMessages = 100000;
+    addons::SPSCCircularBuffer<std::string> channel(64);
+
+    std::thread producer([&channel] {
+        for (auto i = 0; i < kMessages; i++) {
+            while (!channel.try_push_back(std::to_string(i))) {}
+        }
+    });
+
+    for (auto i = 0; i < kMessages; i++) {
+        std::optional<std::string> popped;
+        while (!(popped = channel.try_pop_front())) {}
+        ASSERT_EQ(*popped, std::to_string(i));
+    }
+    producer.join();
+    ASSERT_TRUE(channel.empty());
+}
+
+TEST(CircularBufferTestSuit, MpmcBufferTest) {
+    addons::MPMCCircularBuffer<int> a(3);
+    ASSERT_EQ(a.capacity(), 4);
+
+    ASSERT_TRUE(a.try_push_back(1));
+    ASSERT_TRUE(a.try_push_back(2));
+    ASSERT_TRUE(a.try_push_back(3));
+    ASSERT_TRUE(a.try_push_back(4));
+    ASSERT_FALSE(a.try_push_back(5));
+
+    ASSERT_EQ(a.try_pop_front(), 1);
+    ASSERT_EQ(a.try_pop_front(), 2);
+    ASSERT_EQ(a.try_pop_front(), 3);
+    ASSERT_EQ(a.try_pop_front(), 4);
+    ASSERT_EQ(a.try_pop_front(), std::nullopt);
+
+    constexpr int kProducers = 4;
+    constexpr int kConsumers = 4;
+    constexpr int kPerProducer = 20000;
+    addons::MPMCCircularBuffer<int> channel(128);
+    std::atomic<long long> consumed_sum{0};
+    std::atomic<int> consumed_count{0};
+
+    std::vector<std::thread> workers;
+    for (auto p = 0; p < kProducers; p++) {
+        workers.emplace_back([&channel, p] {
+            for (auto i = 0; i < kPerProducer; i++) {
+                while (!channel.try_push_back(p * kPerProducer + i)) {}
+            }
+        });
+    }
+    for (auto c = 0; c < kConsumers; c++) {
+        workers.emplace_back([&channel, &consumed_sum, &consumed_count] {
+            while (consumed_count.load() < kProducers * kPerProducer) {
+                if (auto popped = channel.try_pop_front()) {
+                    consumed_sum += *popped;
+                    consumed_count++;
+                }
+            }
+        });
+    }
+    for (auto& worker: workers) {
+        worker.join();
+    }
+
+    const long long total = kProducers * kPerProducer;
+    ASSERT_EQ(consumed_count.load(), total);
+    ASSERT_EQ(consumed_sum.load(), total * (total - 1) / 2);
+    ASSERT_TRUE(channel.empty());
+}
+
+TEST(CircularBufferTestSuit, BulkOperationsTest) {
+    addons::CircularBuffer<int> a(8);
+    int src[] = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
+
+    a.push_back_n(src, 5);
+    ASSERT_EQ(a.size(), 5);
+    for (auto i = 0; i < 5; i++) {
+        ASSERT_EQ(a[i], i);
+    }
+
+    // Overwrites the two oldest elements
+    a.push_back_n(src + 5, 5);
+    ASSERT_EQ(a.size(), 8);
+    for (auto i = 0; i < 8; i++) {
+        ASSERT_EQ(a[i], i + 2);
+    }
+
+    int dst[8] = {};
+    ASSERT_EQ(a.pop_front_n(dst, 3), 3);
+    ASSERT_EQ(a.size(), 5);
+    for (auto i = 0; i < 3; i++) {
+        ASSERT_EQ(dst[i], i + 2);
+    }
+    ASSERT_EQ(a.front(), 5);
+
+    // More elements than the whole capacity: only the last 8 survive
+    int wide[20];
+    for (auto i = 0; i < 20; i++) {
+        wide[i] = i;
+    }
+    a.push_back_n(wide, 20);
+    ASSERT_EQ(a.size(), 8);
+    for (auto i = 0; i < 8; i++) {
+        ASSERT_EQ(a[i], i + 12);
+    }
+
+    addons::CircularBufferExt<int> b;
+    b.append(std::span<const int>(src, 10));
+    ASSERT_EQ(b.size(), 10);
+    b.push_back_n(src, 10);
+    ASSERT_EQ(b.size(), 20);
+    for (auto i = 0; i < 20; i++) {
+        ASSERT_EQ(b[i], i % 10);
+    }
+
+    addons::CircularBuffer<std::string> c = {"w", "x", "y", "z"};
+    std::string words[] = {"one", "two", "three", "four", "five"};
+    c.push_back_n(words, 5);
+    ASSERT_EQ(c.size(), 4);
+    ASSERT_EQ(c.front(), "two");
+    ASSERT_EQ(c.back(), "five");
+
+    std::string popped[2];
+    ASSERT_EQ(c.pop_front_n(popped, 2), 2);
+    ASSERT_EQ(popped[0], "two");
+    ASSERT_EQ(popped[1], "three");
+    ASSERT_EQ(c.size(), 2);
+}
+
+TEST(CircularBufferTestSuit, SegmentViewTest) {
+    addons::CircularBuffer<int> a = {1, 2, 3, 4, 5};
+
+    auto one = a.array_one();
+    auto two = a.array_two();
+    ASSERT_EQ(one.second, 5);
+    ASSERT_EQ(two.second, 0);
+    ASSERT_EQ(one.first[0], 1);
+
+    // Wrap the buffer: the content now spans two physical runs
+    a.push_back(6);
+    a.push_back(7);
+    one = a.array_one();
+    two = a.array_two();
+    ASSERT_EQ(one.second + two.second, a.size());
+    ASSERT_EQ(two.second, 2);
+    ASSERT_EQ(one.first[0], 3);
+    ASSERT_EQ(two.first[0], 6);
+    ASSERT_EQ(two.first[1], 7);
+
+    int* flat = a.linearize();
+    ASSERT_EQ(a.array_two().second, 0);
+    ASSERT_EQ(a.size(), 5);
+    for (auto i = 0; i < 5; i++) {
+        ASSERT_EQ(flat[i], i + 3);
+    }
+
+    addons::CircularBufferExt<int> b;
+    ASSERT_EQ(b.array_one().second, 0);
+    ASSERT_EQ(b.array_two().second, 0);
+    b.push_back(10);
+    ASSERT_EQ(b.array_one().second, 1);
+    ASSERT_EQ(*b.array_one().first, 10);
+}
+
+TEST(CircularBufferTestSuit, SegmentIterationTest) {
+    addons::CircularBuffer<int> a = {1, 2, 3, 4, 5, 6};
+    a.push_back(7);
+    a.push_back(8);
+
+    long expected = 0;
+    for (auto i = a.begin(); i < a.end(); i++) {
+        expected += *i;
+    }
+
+    long checksum = 0;
+    int calls = 0;
+    a.for_each_segment([&checksum, &calls](const int* first, const int* last) {
+        calls++;
+        while (first != last) {
+            checksum += *first++;
+        }
+    });
+    ASSERT_EQ(calls, 2);
+    ASSERT_EQ(checksum, expected);
+
+    auto segs = a.segments();
+    ASSERT_EQ(segs[0].second + segs[1].second, a.size());
+
+    addons::CircularBufferExt<int> b;
+    b.push_back(10);
+    b.push_back(20);
+    int seg_calls = 0;
+    long seg_sum = 0;
+    b.for_each_segment([&seg_calls, &seg_sum](int* first, int* last) {
+        seg_calls++;
+        seg_sum += std::accumulate(first, last, 0L);
+    });
+    ASSERT_EQ(seg_calls, 1);
+    ASSERT_EQ(seg_sum, 30);
+}
+
+constexpr int static_buffer_tail_sum() {
+    addons::CircularBufferStatic<int, 4> buf;
+    for (auto i = 1; i <= 6; i++) {
+        buf.push_back(i);
+    }
+    int sum = 0;
+    for (auto i = buf.begin(); i < buf.end(); ++i) {
+        sum += *i;
+    }
+    return sum;
+}
+
+TEST(CircularBufferTestSuit, StaticBufferTest) {
+    // Overwrote 1 and 2, keeps 3 + 4 + 5 + 6 - already at compile time
+    static_assert(static_buffer_tail_sum() == 18);
+    static_assert(addons::CircularBufferStatic<int, 8>().capacity() == 8);
+
+    addons::CircularBufferStatic<std::string, 3> a;
+    ASSERT_TRUE(a.empty());
+    ASSERT_EQ(a.capacity(), 3);
+
+    a.push_back("one");
+    a.push_back("two");
+    a.push_back("three");
+    ASSERT_TRUE(a.full());
+
+    a.push_back("four");
+    ASSERT_EQ(a.front(), "two");
+    ASSERT_EQ(a.back(), "four");
+    ASSERT_EQ(a[1], "three");
+
+    a.push_front("zero");
+    ASSERT_EQ(a.front(), "zero");
+    ASSERT_EQ(a.back(), "three");
+
+    a.pop_front();
+    a.pop_back();
+    ASSERT_EQ(a.size(), 1);
+    ASSERT_EQ(a.front(), "two");
+
+    addons::CircularBufferStatic<int, 5> b = {9, 4, 7, 1, 8};
+    std::sort(b.begin(), b.end());
+    int sorted_b[] = {1, 4, 7, 8, 9};
+    int n = 0;
+    for (auto i = b.begin(); i < b.end(); ++i, ++n) {
+        ASSERT_EQ(*i, sorted_b[n]);
+    }
+
+    b.clear();
+    ASSERT_TRUE(b.empty());
+}
+
+TEST(CircularBufferTestSuit, RangeInsertTest) {
+    addons::CircularBuffer<int> a = {1, 2, 3, 4, 5, 6};
+    a.pop_front();
+    a.pop_front();
+    a.push_back(7);
+    a.push_back(8);
+
+    int key[] = {100, 200};
+    a.insert(a.begin() + 2, key, key + 2);
+    int init_a[] = {3, 4, 100, 200, 5, 6};
+
+    ASSERT_EQ(a.size(), 6);
+    int n = 0;
+    for (auto i = a.begin(); i < a.end(); ++i, ++n) {
+        ASSERT_EQ(*i, init_a[n]);
+    }
+
+    addons::CircularBufferExt<std::string> b = {"aa", "bb", "cc"};
+    b.insert(b.begin() + 1, 3, "xx");
+    std::string init_b[] = {"aa", "xx", "xx", "xx", "bb", "cc"};
+
+    ASSERT_EQ(b.size(), 6);
+    ASSERT_GE(b.capacity(), 6);
+    n = 0;
+    for (auto i = b.begin(); i < b.end(); ++i, ++n) {
+        ASSERT_EQ(*i, init_b[n]);
+    }
+
+    // Inserting at the arithmetic end appends instead of wrapping to 0
+    addons::CircularBuffer<int> c(5);
+    c.push_back(10);
+    c.push_back(11);
+    c.insert(c.begin() + 2, 2, 99);
+    int init_c[] = {10, 11, 99, 99};
+
+    ASSERT_EQ(c.size(), 4);
+    n = 0;
+    for (auto i = c.begin(); i < c.end(); ++i, ++n) {
+        ASSERT_EQ(*i, init_c[n]);
+    }
+
+    addons::CircularBufferExt<int> d = {1, 2};
+    int tail_key[] = {3, 4};
+    d.insert(d.begin() + 2, tail_key, tail_key + 2);
+    int init_d[] = {1, 2, 3, 4};
+
+    ASSERT_EQ(d.size(), 4);
+    n = 0;
+    for (auto i = d.begin(); i < d.end(); ++i, ++n) {
+        ASSERT_EQ(*i, init_d[n]);
+    }
+}
+
+TEST(CircularBufferTestSuit, OverflowPolicyTest) {
+    addons::CircularBuffer<int> a(3, 0);
+
+    ASSERT_FALSE(a.try_push_back(4));
+    ASSERT_FALSE(a.try_push_front(5));
+    ASSERT_EQ(a.size(), 3);
+
+    auto popped = a.try_pop_front();
+    ASSERT_TRUE(popped.has_value());
+    ASSERT_EQ(*popped, 0);
+    ASSERT_TRUE(a.try_push_back(4));
+    ASSERT_EQ(a.back(), 4);
+    ASSERT_EQ(a.size(), 3);
+
+    addons::CircularBuffer<int, std::allocator<int>, addons::OverflowPolicy::Reject> b = {1, 2, 3};
+    b.push_back(4);
+    b.push_front(5);
+    ASSERT_EQ(b.emplace_back(6), 3);
+    ASSERT_EQ(b.emplace_front(7), 1);
+    int init_b[] = {1, 2, 3};
+
+    ASSERT_EQ(b.size(), 3);
+    int n = 0;
+    for (auto i = b.begin(); i < b.end(); ++i, ++n) {
+        ASSERT_EQ(*i, init_b[n]);
+    }
+
+    // Bulk append under Reject keeps only the leading elements that fit
+    addons::CircularBuffer<int, std::allocator<int>, addons::OverflowPolicy::Reject> d(5);
+    d.push_back(1);
+    int extra[] = {2, 3, 4, 5, 6, 7};
+    d.push_back_n(extra, 6);
+    ASSERT_EQ(d.size(), 5);
+    for (int i = 0; i < 5; i++) {
+        ASSERT_EQ(d[i], i + 1);
+    }
+
+    addons::CircularBuffer<std::string, std::allocator<std::string>, addons::OverflowPolicy::Reject> e = {"one", "two"};
+    std::string words[] = {"three", "four"};
+    e.push_back_n(words, 2);
+    ASSERT_EQ(e.size(), 2);
+    ASSERT_EQ(e.front(), "one");
+    ASSERT_EQ(e.back(), "two");
+
+    addons::CircularBuffer<int> c;
+    ASSERT_FALSE(c.try_pop_front().has_value());
+}
+
+TEST(CircularBufferTestSuit, ConsumeTest) {
+    addons::CircularBuffer<int> a = {1, 2, 3, 4, 5, 6};
+    a.pop_front();
+    a.pop_front();
+    a.push_back(7);
+    a.push_back(8);
+
+    std::vector<int> drained;
+    int calls = 0;
+    auto consumed = a.consume_all([&](const int* first, const int* last) {
+        calls++;
+        drained.insert(drained.end(), first, last);
+    });
+
+    ASSERT_EQ(consumed, 6);
+    ASSERT_EQ(calls, 2);
+    ASSERT_TRUE(a.empty());
+    std::vector<int> expected = {3, 4, 5, 6, 7, 8};
+    ASSERT_EQ(drained, expected);
+
+    addons::CircularBufferExt<std::string> b = {"aa", "bb", "cc", "dd"};
+    std::vector<std::string> taken;
+    auto taken_n = b.consume_n(2, [&](std::string* first, std::string* last) {
+        for (; first != last; first++) {
+            taken.push_back(std::move(*first));
+        }
+    });
+
+    ASSERT_EQ(taken_n, 2);
+    ASSERT_EQ(b.size(), 2);
+    ASSERT_EQ(taken[0], "aa");
+    ASSERT_EQ(taken[1], "bb");
+    ASSERT_EQ(b.front(), "cc");
+
+    b.push_back("ee");
+    ASSERT_EQ(b.back(), "ee");
+}
+
+#ifdef CIRCULARBUFFER_STATS
+TEST(CircularBufferTestSuit, StatsTest) {
+    addons::CircularBufferExt<int> a;
+    for (int i = 0; i < 100; i++) {
+        a.push_back(i);
+    }
+
+    ASSERT_GT(a.stats().reallocations, 0);
+    ASSERT_GT(a.stats().bytes_relocated, 0);
+    ASSERT_EQ(a.stats().max_occupancy, 100);
+    ASSERT_EQ(a.stats().overwritten, 0);
+
+    addons::CircularBuffer<int> b(4, 0);
+    b.push_back(1);
+    b.push_back(2);
+
+    ASSERT_EQ(b.stats().overwritten, 2);
+    ASSERT_EQ(b.stats().reallocations, 0);
+
+    b.pop_front();
+    b.pop_front();
+    b.pop_front();
+    b.pop_front();
+    ASSERT_GT(b.stats().wrap_arounds, 0);
+
+    // Bulk drops are counted too, including the n >= capacity fast path
+    addons::CircularBuffer<int> c(4, 0);
+    int bulk[] = {1, 2};
+    c.push_back_n(bulk, 2);
+    ASSERT_EQ(c.stats().overwritten, 2);
+
+    int flood[] = {1, 2, 3, 4, 5, 6};
+    c.push_back_n(flood, 6);
+    ASSERT_EQ(c.stats().overwritten, 8);
+}
+#endif
+
+#ifdef __unix__
+TEST(CircularBufferTestSuit, FdTransferTest) {
+    addons::CircularBuffer<int> a = {1, 2, 3, 4, 5, 6};
+    a.pop_front();
+    a.pop_front();
+    a.push_back(7);
+    a.push_back(8);
+
+    int fds[2];
+    ASSERT_EQ(pipe(fds), 0);
+
+    ASSERT_EQ(a.write_to_fd(fds[1]), 6);
+    ASSERT_TRUE(a.empty());
+
+    addons::CircularBuffer<int> b(8);
+    ASSERT_EQ(b.read_from_fd(fds[0], 6), 6);
+    int init_b[] = {3, 4, 5, 6, 7, 8};
+
+    ASSERT_EQ(b.size(), 6);
+    int n = 0;
+    for (auto i = b.begin(); i < b.end(); ++i, ++n) {
+        ASSERT_EQ(*i, init_b[n]);
+    }
+
+    close(fds[0]);
+    close(fds[1]);
+}
+#endif
+
+TEST(CircularBufferTestSuit, SegmentAlgorithmsTest) {
+    addons::CircularBuffer<int> a = {1, 2, 3, 4, 5, 6};
+    a.pop_front();
+    a.pop_front();
+    a.push_back(7);
+
+    auto found = addons::find(a, 7);
+    ASSERT_EQ(found - a.begin(), 4);
+    ASSERT_EQ(addons::find(a, 100), a.end());
+
+    ASSERT_EQ(*addons::min_element(a), 3);
+    ASSERT_EQ(*addons::max_element(a), 7);
+    ASSERT_EQ(addons::max_element(a) - a.begin(), 4);
+
+    ASSERT_EQ(addons::accumulate(a, 0), 3 + 4 + 5 + 6 + 7);
+    ASSERT_EQ(addons::reduce(a, 1, [](int acc, int value) { return acc * value; }), 3 * 4 * 5 * 6 * 7);
+    ASSERT_EQ(addons::count(a, 4), 1);
+    ASSERT_EQ(addons::count(a, 100), 0);
+
+    addons::CircularBufferExt<int> b;
+    ASSERT_EQ(addons::min_element(b), b.end());
+    ASSERT_EQ(addons::accumulate(b, 10), 10);
+}
+
+#ifdef __unix__
+TEST(CircularBufferTestSuit, MappedBufferTest) {
+    const std::string path = ::testing::TempDir() + "mapped_buffer_test.bin";
+    ::unlink(path.c_str());
+
+    {
+        addons::MappedCircularBuffer<int> a(path.c_str(), 4);
+        ASSERT_TRUE(a.empty());
+        for (int i = 1; i <= 6; i++) {
+            a.push_back(i);
+        }
+        ASSERT_TRUE(a.full());
+        ASSERT_EQ(a.front(), 3);
+        a.flush();
+    }
+
+    {
+        addons::MappedCircularBuffer<int> b(path.c_str(), 4);
+        int init_b[] = {3, 4, 5, 6};
+
+        ASSERT_EQ(b.size(), 4);
+        for (int n = 0; n < 4; n++) {
+            ASSERT_EQ(b[n], init_b[n]);
+        }
+
+        b.pop_front();
+        ASSERT_EQ(b.front(), 4);
+    }
+
+    ASSERT_THROW(addons::MappedCircularBuffer<double>(path.c_str(), 4), std::runtime_error);
+
+    ::unlink(path.c_str());
+}
+#endif
+
+TEST(CircularBufferTestSuit, PoolAllocatorTest) {
+    addons::PoolAllocator<int> pool;
+
+    int* block = pool.allocate(16);
+    pool.deallocate(block, 16);
+    ASSERT_EQ(pool.allocate(16), block);
+    pool.deallocate(block, 16);
+
+    addons::PoolAllocator<int> copy = pool;
+    ASSERT_EQ(copy, pool);
+    ASSERT_EQ(copy.allocate(16), block);
+    copy.deallocate(block, 16);
+
+    ASSERT_NE(addons::PoolAllocator<int>(), pool);
+
+    addons::CircularBuffer<std::string, addons::PoolAllocator<std::string>> a = {"aa", "bb", "cc"};
+    addons::CircularBuffer<std::string, addons::PoolAllocator<std::string>> b = a;
+    b.push_back("dd");
+    ASSERT_EQ(b.front(), "bb");
+    ASSERT_EQ(a.size(), 3);
+
+    addons::CircularBufferExt<int, addons::PoolAllocator<int>> c;
+    for (int i = 0; i < 100; i++) {
+        c.push_back(i);
+    }
+    ASSERT_EQ(c.size(), 100);
+    ASSERT_EQ(c.back(), 99);
+}
+
+TEST(CircularBufferTestSuit, HugePageAllocatorTest) {
+    addons::HugePageAllocator<int> huge;
+
+    int* small_block = huge.allocate(100);
+    ASSERT_EQ(reinterpret_cast<uintptr_t>(small_block) % 64, 0);
+    huge.deallocate(small_block, 100);
+
+    const size_t big = 1024 * 1024;
+    int* big_block = huge.allocate(big);
+    ASSERT_EQ(reinterpret_cast<uintptr_t>(big_block) % 64, 0);
+    big_block[0] = 1;
+    big_block[big - 1] = 2;
+    huge.deallocate(big_block, big);
+
+    addons::CircularBuffer<int, addons::HugePageAllocator<int>> a(8, 7);
+    a.push_back(9);
+    ASSERT_EQ(a.back(), 9);
+    ASSERT_EQ(a.size(), 8);
+}
+
+TEST(CircularBufferTestSuit, CowSnapshotTest) {
+    addons::CowCircularBuffer<int> a = {1, 2, 3, 4};
+
+    auto snap = a.snapshot();
+    a.push_back(5);
+    a.push_back(6);
+
+    int init_snap[] = {1, 2, 3, 4};
+    ASSERT_EQ(snap.size(), 4);
+    int n = 0;
+    for (auto i = snap.begin(); i < snap.end(); ++i, ++n) {
+        ASSERT_EQ(*i, init_snap[n]);
+    }
+
+    int init_a[] = {3, 4, 5, 6};
+    ASSERT_EQ(a.size(), 4);
+    for (n = 0; n < 4; n++) {
+        ASSERT_EQ(a[n], init_a[n]);
+    }
+
+    auto second = a.snapshot();
+    ASSERT_EQ(second.back(), 6);
+    a.pop_front();
+    ASSERT_EQ(second.size(), 4);
+    ASSERT_EQ(a.size(), 3);
+}
+
+namespace {
+    // Minimal eager task type: runs until its first suspension and is
+    // driven onward by channel resumptions.
+    struct ChannelTask {
+        struct promise_type {
+            ChannelTask get_return_object() { return {}; }
+            std::suspend_never initial_suspend() { return {}; }
+            std::suspend_never final_suspend() noexcept { return {}; }
+            void return_void() {}
+            void unhandled_exception() { std::terminate(); }
+        };
+    };
+}
+
+namespace {
+    // Not trivially copyable, but moving plus destroying one is
+    // equivalent to a plain byte copy
+    struct RelocatableHandle {
+        int payload;
+
+        explicit RelocatableHandle(int _payload = 0) : payload(_payload) {}
+        RelocatableHandle(const RelocatableHandle& _x) : payload(_x.payload) {}
+        RelocatableHandle& operator=(const RelocatableHandle& _x)
+        {
+            payload = _x.payload;
+            return *this;
+        }
+    };
+}
+
+namespace addons {
+    template<>
+    struct is_trivially_relocatable<RelocatableHandle> : std::true_type {};
+}
+
+TEST(CircularBufferTestSuit, ParallelFillTest) {
+    addons::CircularBuffer<int> a(1 << 20, 676, 4);
+    ASSERT_EQ(a.size(), 1 << 20);
+    ASSERT_EQ(a.capacity(), 1 << 20);
+    for (size_t i = 0; i < a.size(); i += 4096)
+        ASSERT_EQ(a[i], 676);
+    ASSERT_EQ(a.front(), 676);
+    ASSERT_EQ(a.back(), 676);
+
+    // Parallel fill must agree with the serial constructor
+    addons::CircularBuffer<std::string> b(1000, "abc", 3);
+    addons::CircularBuffer<std::string> serial(1000, "abc");
+    ASSERT_TRUE(b == serial);
+
+    b.clear(3);
+    ASSERT_EQ(b.size(), 0);
+    ASSERT_EQ(b.capacity(), 0);
+
+    // Degenerate thread counts fall back to the serial path
+    addons::CircularBufferExt<int> c(17, 5, 1);
+    ASSERT_EQ(c.size(), 17);
+    addons::CircularBuffer<int> d(0, 5, 8);
+    ASSERT_TRUE(d.empty());
+}
+
+TEST(CircularBufferTestSuit, TriviallyRelocatableTest) {
+    static_assert(addons::is_trivially_relocatable_v<int>);
+    static_assert(!addons::is_trivially_relocatable_v<std::string>);
+    static_assert(addons::is_trivially_relocatable_v<RelocatableHandle>);
+
+    // Wrapped trivially copyable buffer survives grow and shrink
+    addons::CircularBuffer<int> a{1, 2, 3, 4, 5, 6};
+    a.pop_front();
+    a.pop_front();
+    a.push_back(7);
+    a.push_back(8);
+    a.reserve(12);
+    ASSERT_EQ(a.capacity(), 12);
+    int grown[] = {3, 4, 5, 6, 7, 8};
+    for (size_t i = 0; i < a.size(); i++)
+        ASSERT_EQ(a[i], grown[i]);
+    a.resize(3);
+    a.shrink_to_fit();
+    ASSERT_EQ(a.capacity(), 3);
+    for (size_t i = 0; i < 3; i++)
+        ASSERT_EQ(a[i], grown[i]);
+
+    // Opted-in user type takes the memcpy path without losing values
+    addons::CircularBufferExt<RelocatableHandle> b;
+    for (int i = 0; i < 100; i++)
+        b.push_back(RelocatableHandle(i));
+    ASSERT_EQ(b.size(), 100);
+    for (int i = 0; i < 100; i++)
+        ASSERT_EQ(b[i].payload, i);
+}
+
+TEST(CircularBufferTestSuit, ShardedBufferTest) {
+    constexpr int producers = 4;
+    constexpr int per_producer = 5000;
+    addons::ShardedCircularBuffer<std::pair<int, int>> a(producers, 256);
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < producers; t++) {
+        threads.emplace_back([&a] {
+            const size_t shard = a.register_producer();
+            for (int i = 0; i < per_producer; i++)
+                while (!a.try_push_back(shard, {static_cast<int>(shard), i})) {}
+        });
+    }
+
+    std::vector<int> seen(producers, 0);
+    size_t drained = 0;
+    bool ordered = true;
+    while (drained < producers * per_producer) {
+        drained += a.drain([&](std::pair<int, int> logged) {
+            ordered = ordered && logged.second == seen[logged.first];
+            seen[logged.first]++;
+        });
+    }
+    for (auto& worker: threads)
+        worker.join();
+
+    ASSERT_TRUE(ordered);
+    for (int t = 0; t < producers; t++)
+        ASSERT_EQ(seen[t], per_producer);
+    ASSERT_TRUE(a.empty());
+
+    // Merged drain comes out in key order when shards are key-sorted
+    addons::ShardedCircularBuffer<int> b(2, 8);
+    b.try_push_back(0, 1);
+    b.try_push_back(0, 4);
+    b.try_push_back(0, 6);
+    b.try_push_back(1, 2);
+    b.try_push_back(1, 3);
+    b.try_push_back(1, 5);
+    std::vector<int> merged;
+    b.drain_merged([&](int logged) { merged.push_back(logged); },
+                   [](int logged) { return logged; });
+    ASSERT_EQ(merged, std::vector<int>({1, 2, 3, 4, 5, 6}));
+
+    ASSERT_THROW({
+        addons::ShardedCircularBuffer<int> c(1, 8);
+        c.register_producer();
+        c.register_producer();
+    }, std::length_error);
+}
+
+TEST(CircularBufferTestSuit, ByteRecordTest) {
+    addons::CircularByteBuffer<> a(64);
+
+    auto as_bytes = [](const std::string& s) {
+        return std::span<const std::byte>(reinterpret_cast<const std::byte*>(s.data()), s.size());
+    };
+    auto to_string = [](std::span<const std::byte> first, std::span<const std::byte> second) {
+        std::string out(reinterpret_cast<const char*>(first.data()), first.size());
+        out.append(reinterpret_cast<const char*>(second.data()), second.size());
+        return out;
+    };
+
+    ASSERT_TRUE(a.push(as_bytes("hello")));
+    ASSERT_TRUE(a.push(as_bytes("")));
+    ASSERT_TRUE(a.push(as_bytes("circular byte records")));
+    ASSERT_EQ(a.size(), 3);
+
+    std::vector<std::string> received;
+    ASSERT_EQ(a.consume_all([&](auto first, auto second) {
+        received.push_back(to_string(first, second));
+    }), 3);
+    ASSERT_EQ(received[0], "hello");
+    ASSERT_EQ(received[1], "");
+    ASSERT_EQ(received[2], "circular byte records");
+    ASSERT_TRUE(a.empty());
+
+    // Interleave pushes and pops so records wrap over the physical end
+    received.clear();
+    std::vector<std::string> sent;
+    for (int i = 0; i < 40; i++) {
+        std::string message = "message-" + std::to_string(i) + std::string(i % 17, 'x');
+        sent.push_back(message);
+        while (!a.push(as_bytes(message)))
+            a.consume([&](auto first, auto second) {
+                received.push_back(to_string(first, second));
+            });
+    }
+    a.consume_all([&](auto first, auto second) {
+        received.push_back(to_string(first, second));
+    });
+    ASSERT_EQ(received, sent);
+
+    ASSERT_FALSE(a.push(as_bytes(std::string(100, 'y'))));
+    ASSERT_FALSE(a.consume([](auto, auto) {}));
+}
+
+TEST(CircularBufferTestSuit, ThreeWayCompareTest) {
+    addons::CircularBuffer<int> a{1, 2, 3, 4};
+    addons::CircularBuffer<int> b{1, 2, 3, 4};
+    addons::CircularBuffer<int> c{1, 2, 4};
+
+    ASSERT_TRUE((a <=> b) == std::strong_ordering::equal);
+    ASSERT_TRUE((a <=> c) == std::strong_ordering::less);
+    ASSERT_TRUE((c <=> a) == std::strong_ordering::greater);
+    ASSERT_TRUE((a <=> addons::CircularBuffer<int>{1, 2, 3}) == std::strong_ordering::greater);
+
+    // Wrapped against unwrapped with equal logical contents
+    addons::CircularBuffer<int> d{0, 0, 2, 3, 4, 5};
+    d.pop_front();
+    d.pop_front();
+    d.push_back(6);
+    d.push_back(7);
+    addons::CircularBuffer<int> e{2, 3, 4, 5, 6, 7};
+    ASSERT_TRUE(d == e);
+    ASSERT_FALSE(d != e);
+    ASSERT_TRUE((d <=> e) == std::strong_ordering::equal);
+    ASSERT_TRUE(d <= e);
+    ASSERT_TRUE(d >= e);
+
+    addons::CircularBuffer<unsigned char> f{1, 200, 3};
+    addons::CircularBuffer<unsigned char> g{1, 199, 3};
+    ASSERT_TRUE(f > g);
+    ASSERT_TRUE((f <=> g) == std::strong_ordering::greater);
+}
+
+TEST(CircularBufferTestSuit, DumpRestoreTest) {
+    addons::CircularBuffer<int> a{1, 2, 3, 4, 5, 6};
+    a.pop_front();
+    a.pop_front();
+    a.push_back(7);
+    a.push_back(8);
+
+    std::stringstream checkpoint;
+    a.dump(checkpoint);
+
+    addons::CircularBuffer<int> b;
+    b.restore(checkpoint);
+
+    ASSERT_EQ(b.size(), a.size());
+    ASSERT_EQ(b.capacity(), a.capacity());
+    for (size_t i = 0; i < a.size(); i++)
+        ASSERT_EQ(b[i], a[i]);
+
+    std::stringstream wrong_type;
+    a.dump(wrong_type);
+    addons::CircularBuffer<double> c;
+    ASSERT_THROW(c.restore(wrong_type), std::runtime_error);
+
+    std::stringstream truncated(checkpoint.str().substr(0, checkpoint.str().size() - 4));
+    addons::CircularBuffer<int> d;
+    ASSERT_THROW(d.restore(truncated), std::runtime_error);
+}
+
+TEST(CircularBufferTestSuit, CoroutineChannelTest) {
+    addons::ChannelCircularBuffer<int> a(4);
+    std::vector<int> received;
+
+    auto consumer = [&]() -> ChannelTask {
+        for (int i = 0; i < 10; i++)
+            received.push_back(co_await a.async_pop());
+    };
+    auto producer = [&]() -> ChannelTask {
+        for (int i = 0; i < 10; i++)
+            co_await a.async_push(i);
+    };
+
+    consumer();
+    ASSERT_TRUE(received.empty());
+    producer();
+
+    ASSERT_EQ(received.size(), 10);
+    for (int i = 0; i < 10; i++)
+        ASSERT_EQ(received[i], i);
+
+    addons::ChannelCircularBuffer<int> b(2);
+    int produced = 0;
+    std::vector<int> drained;
+
+    auto producer2 = [&]() -> ChannelTask {
+        for (int i = 0; i < 5; i++) {
+            co_await b.async_push(i);
+            produced++;
+        }
+    };
+    auto consumer2 = [&]() -> ChannelTask {
+        for (int i = 0; i < 5; i++)
+            drained.push_back(co_await b.async_pop());
+    };
+
+    producer2();
+    ASSERT_EQ(produced, 2);
+    consumer2();
+
+    ASSERT_EQ(produced, 5);
+    ASSERT_EQ(drained.size(), 5);
+    for (int i = 0; i < 5; i++)
+        ASSERT_EQ(drained[i], i);
+    ASSERT_TRUE(b.empty());
+}
+
+TEST(CircularBufferTestSuit, WaitableBufferTest) {
+    addons::WaitableCircularBuffer<int> a(64);
+
+    ASSERT_FALSE(a.pop_front_wait(std::chrono::milliseconds(10)).has_value());
+
+    constexpr int total = 20000;
+    std::thread producer([&a] {
+        for (int i = 0; i < total; i++) {
+            a.push_back_wait(i);
+        }
+    });
+
+    long long sum = 0;
+    int expected = 0;
+    bool ordered = true;
+    for (int received = 0; received < total; received++) {
+        auto popped = a.pop_front_wait(std::chrono::seconds(30));
+        ASSERT_TRUE(popped.has_value());
+        ordered = ordered && *popped == expected++;
+        sum += *popped;
+    }
+    producer.join();
+
+    ASSERT_TRUE(ordered);
+    ASSERT_EQ(sum, static_cast<long long>(total) * (total - 1) / 2);
+    ASSERT_TRUE(a.empty());
+
+    ASSERT_TRUE(a.try_push_back(42));
+    ASSERT_EQ(a.pop_front_wait(), 42);
+}
+
 TEST(CircularBufferTestSuit, EraseTest) {
     addons::CircularBuffer<std::string> a = {"12", "ABc", "Key", "aBCCD", "Leeks", "Lakes", "", "This is end..."};
 
@@ -324,3 +1460,56 @@ TEST(CircularBufferTestSuit, EraseTest) {
     }
 }
 
+TEST(CircularBufferTestSuit, RangeEraseTest) {
+    addons::CircularBuffer<std::string> a = {"12", "ABc", "Key", "aBCCD", "Leeks", "Lakes", "", "This is end..."};
+
+    auto next = a.erase(a.begin() + 2, a.begin() + 5);
+    std::string init_a[] = {"12", "ABc", "Lakes", "", "This is end..."};
+
+    ASSERT_EQ(a.size(), 5);
+    ASSERT_EQ(*next, "Lakes");
+    int n = 0;
+    for (auto i = a.begin(); i < a.end(); ++i, ++n) {
+        ASSERT_EQ(*i, init_a[n]);
+    }
+
+    addons::CircularBuffer<int> b = {1, 2, 3, 4, 5, 6};
+    b.pop_front();
+    b.pop_front();
+    b.push_back(7);
+    b.push_back(8);
+
+    b.erase(b.begin() + 1, b.begin() + 3);
+    int init_b[] = {3, 6, 7, 8};
+
+    ASSERT_EQ(b.size(), 4);
+    n = 0;
+    for (auto i = b.begin(); i < b.end(); ++i, ++n) {
+        ASSERT_EQ(*i, init_b[n]);
+    }
+
+    // Erasing a tail range of a not-full buffer must not wrap the indices
+    addons::CircularBuffer<int> c(5);
+    c.push_back(10);
+    c.push_back(11);
+    c.push_back(12);
+
+    auto after = c.erase(c.begin() + 1, c.begin() + 3);
+    ASSERT_EQ(c.size(), 1);
+    ASSERT_EQ(c.front(), 10);
+    ASSERT_EQ(after, c.end());
+
+    // Erasing everything leaves a usable empty buffer
+    c.erase(c.begin(), c.end());
+    ASSERT_TRUE(c.empty());
+    c.push_back(13);
+    ASSERT_EQ(c.front(), 13);
+
+    addons::CircularBufferExt<int> d = {1, 2, 3};
+    d.erase(d.begin() + 1, d.begin() + 3);
+    ASSERT_EQ(d.size(), 1);
+    ASSERT_EQ(d.front(), 1);
+    d.erase(d.begin(), d.end());
+    ASSERT_TRUE(d.empty());
+}
+